@@ -7,7 +7,17 @@ Uses environment variables with sensible defaults.
 
 import os
 from pathlib import Path
-from typing import Optional
+from typing import List, Optional, Tuple
+
+
+def _parse_regions(text: str) -> List[Tuple[float, float, float, float]]:
+    """Parse "x,y,w,h;x,y,w,h" (fractions of the frame size) into rectangles."""
+    regions = []
+    for item in text.split(";"):
+        if item.strip():
+            x, y, w, h = (float(v) for v in item.split(","))
+            regions.append((x, y, w, h))
+    return regions
 
 
 class Settings:
@@ -24,6 +34,21 @@ class Settings:
         # Slide Detection Settings
         MIN_SCENE_DURATION: Minimum duration between slides (seconds)
         MIN_AREA_RATIO: Minimum area ratio for slide detection
+        ANALYSIS_FPS: Frames per second analyzed by the detector (0 = all frames)
+        COARSE_THRESHOLD: Thumbnail difference below which frames skip edge detection
+        COMPUTE_BACKEND: Where frames are analyzed ("cpu" or "opencl")
+        DECODE_ACCELERATION: Hardware video decoding ("none", "any", "vaapi", "d3d11", "mfx")
+        REDUCED_DECODE: Decode gray analysis-size frames instead of full-resolution BGR
+        RESULT_CACHE_DIR: Directory of cached detection results ("" = off)
+        REVISIT_HISTORY: Distinct slides remembered for revisit detection (0 = off)
+        ADAPTIVE_THRESHOLD: Trigger relative to the video's noise floor, in robust deviations (0 = off)
+        EXCLUDE_REGIONS: Ignored frame areas, e.g. a webcam overlay ("x,y,w,h;..." in fractions)
+        AUTO_EXCLUDE_SECONDS: Seconds searched for a moving overlay to exclude (0 = off)
+        ENGINE_THREADS: Videos detected at once in batch processing (0 = one per CPU core)
+        OCR_TEXT_REGIONS: OCR only the text blocks cut out of each slide, not the whole frame
+        OCR_BINARIZE: Binarize those text blocks (black on white) before OCR
+        MEMORY_BUDGET_MB: Memory of one detection scan; slides over it are spilled to disk (0 = unlimited)
+        SPILL_DIR: Directory of the spilled slides
 
         # API Settings
         API_HOST: API server host
@@ -46,6 +71,21 @@ class Settings:
     # Slide detection defaults
     MIN_SCENE_DURATION: float = float(os.getenv("MIN_SCENE_DURATION", "2.0"))
     MIN_AREA_RATIO: float = float(os.getenv("MIN_AREA_RATIO", "0.15"))
+    ANALYSIS_FPS: float = float(os.getenv("ANALYSIS_FPS", "5.0"))
+    COARSE_THRESHOLD: float = float(os.getenv("COARSE_THRESHOLD", "1.0"))
+    COMPUTE_BACKEND: str = os.getenv("COMPUTE_BACKEND", "cpu").lower()
+    DECODE_ACCELERATION: str = os.getenv("DECODE_ACCELERATION", "none").lower()
+    REDUCED_DECODE: bool = os.getenv("REDUCED_DECODE", "False").lower() in ("true", "1", "yes")
+    RESULT_CACHE_DIR: str = os.getenv("RESULT_CACHE_DIR", str(DATA_DIR / "cache"))
+    REVISIT_HISTORY: int = int(os.getenv("REVISIT_HISTORY", "32"))
+    ADAPTIVE_THRESHOLD: float = float(os.getenv("ADAPTIVE_THRESHOLD", "0"))
+    EXCLUDE_REGIONS: List[Tuple[float, float, float, float]] = _parse_regions(os.getenv("EXCLUDE_REGIONS", ""))
+    AUTO_EXCLUDE_SECONDS: float = float(os.getenv("AUTO_EXCLUDE_SECONDS", "0"))
+    ENGINE_THREADS: int = int(os.getenv("ENGINE_THREADS", "0"))
+    OCR_TEXT_REGIONS: bool = os.getenv("OCR_TEXT_REGIONS", "True").lower() in ("true", "1", "yes")
+    OCR_BINARIZE: bool = os.getenv("OCR_BINARIZE", "False").lower() in ("true", "1", "yes")
+    MEMORY_BUDGET_MB: int = int(os.getenv("MEMORY_BUDGET_MB", "0"))
+    SPILL_DIR: str = os.getenv("SPILL_DIR", str(DATA_DIR / "spill"))
 
     # API configuration
     API_HOST: str = os.getenv("API_HOST", "0.0.0.0")
@@ -81,6 +121,21 @@ class Settings:
             "data_dir": str(cls.DATA_DIR),
             "min_scene_duration": cls.MIN_SCENE_DURATION,
             "min_area_ratio": cls.MIN_AREA_RATIO,
+            "analysis_fps": cls.ANALYSIS_FPS,
+            "coarse_threshold": cls.COARSE_THRESHOLD,
+            "compute_backend": cls.COMPUTE_BACKEND,
+            "decode_acceleration": cls.DECODE_ACCELERATION,
+            "reduced_decode": cls.REDUCED_DECODE,
+            "result_cache_dir": cls.RESULT_CACHE_DIR,
+            "revisit_history": cls.REVISIT_HISTORY,
+            "adaptive_threshold": cls.ADAPTIVE_THRESHOLD,
+            "exclude_regions": cls.EXCLUDE_REGIONS,
+            "auto_exclude_seconds": cls.AUTO_EXCLUDE_SECONDS,
+            "engine_threads": cls.ENGINE_THREADS,
+            "ocr_text_regions": cls.OCR_TEXT_REGIONS,
+            "ocr_binarize": cls.OCR_BINARIZE,
+            "memory_budget_mb": cls.MEMORY_BUDGET_MB,
+            "spill_dir": cls.SPILL_DIR,
             "api_host": cls.API_HOST,
             "api_port": cls.API_PORT,
             "debug": cls.DEBUG,
@@ -1,9 +1,11 @@
 import logging
 import multiprocessing
-import cv2
+import os
+import queue
 from pathlib import Path
-from typing import Any, Dict, List
+from typing import Any, Dict, List, Optional
 
+from backend.core.config import settings
 from backend.services.audio_service import AudioService
 from backend.services.video_service import SlideDetectionService
 from backend.services.llm_service import LLMJudgeService
@@ -15,15 +17,22 @@ logger = logging.getLogger(__name__)
 
 
 def _ocr_worker_task(
-    video_path: str, slides_metadata: List[Dict], language: str = "en"
-) -> List[Dict]:
+    video_path: str, slide_queue, result_queue, language: str = "en"
+) -> None:
     """
     Эта функция запускается в ОТДЕЛЬНОМ процессе.
     Здесь безопасно грузить PaddleOCR, так как Torch здесь нет.
 
+    Слайды приходят через slide_queue по мере того, как их находит детектор
+    (None - слайдов больше не будет), так что OCR первых слайдов идет
+    параллельно со сканированием остального видео.
+
     Args:
         video_path: Path to the video file
-        slides_metadata: List of detected slides with frame_index and timestamp
+        slide_queue: Detected slides (frame_index, timestamp_sec, image_bytes or image_path,
+            text_regions if found, changed_regions / is_build_up and the
+            previous_slide_id set by analyze_content), then None
+        result_queue: Receives the list of OCR results once slide_queue is exhausted
         language: ISO 639-1 language code detected from audio (e.g., 'en', 'es', 'fr')
     """
     import logging
@@ -32,12 +41,10 @@ def _ocr_worker_task(
     logging.basicConfig(level=logging.INFO)
     worker_logger = logging.getLogger("OCR_Worker")
 
-    worker_logger.info(
-        f"Worker started. Processing {len(slides_metadata)} slides with language={language}..."
-    )
+    worker_logger.info(f"Worker started with language={language}...")
 
     results = []
-    cap = None
+    processed = 0
 
     try:
         # --- FIX: Запрещаем Paddle перехватывать системные сигналы (SIGTERM) ---
@@ -47,43 +54,77 @@ def _ocr_worker_task(
         # -----------------------------------------------------------------------
 
         # 1. Lazy Import внутри процесса
+        import cv2
+        import numpy as np
         from backend.services.ocr_service import OcrService
 
         ocr_service = OcrService(lang=language)
+        video_service = None
+
+        def decode(image_bytes, flags=cv2.IMREAD_COLOR):
+            return cv2.imdecode(np.frombuffer(image_bytes, np.uint8), flags)
+
+        def crop(frame, rect):
+            # rect - доли кадра (x, y, width, height)
+            h, w = frame.shape[:2]
+            x, y, rw, rh = rect
+            return frame[int(y * h) : int((y + rh) * h), int(x * w) : int((x + rw) * w)]
+
+        def full_frame(slide):
+            # Кадр уже захвачен детектором (image_bytes или файл сверх бюджета памяти).
+            # Если нет - достаем его из видео
+            nonlocal video_service
+            if "image_bytes" in slide:
+                return decode(slide["image_bytes"])
+            if "image_path" in slide:
+                return cv2.imread(slide["image_path"], cv2.IMREAD_COLOR)
+            if video_service is None:
+                video_service = SlideDetectionService()
+            return video_service.get_frame(video_path, slide["frame_index"])
 
-        # 2. Открываем видео (OpenCV безопасен в мультипроцессинге)
-        cap = cv2.VideoCapture(video_path)
-        if not cap.isOpened():
-            worker_logger.error("Failed to open video in worker")
-            return []
+        text_by_id = {}
 
-        # 3. Пробегаем по списку найденных слайдов
-        for slide in slides_metadata:
+        # 2. Берем слайды из очереди, пока детектор не закончит
+        for slide in iter(slide_queue.get, None):
+            processed += 1
             frame_idx = slide["frame_index"]
             timestamp = slide["timestamp_sec"]
+            previous_text = text_by_id.get(slide.get("previous_slide_id"))
 
-            # Прыгаем к кадру
-            cap.set(cv2.CAP_PROP_POS_FRAMES, frame_idx)
-            ret, frame = cap.read()
-
-            if ret:
-                text = ocr_service.extract_text(frame)
-                if text and len(text.strip()) > 3:
-                    results.append(
-                        {
-                            "timestamp": timestamp,
-                            "frame_index": frame_idx,
-                            "ocr_text": text,
-                        }
-                    )
+            # Появился новый пункт на том же слайде: распознаем только добавленное
+            # и дописываем к тексту предыдущего слайда
+            if slide.get("is_build_up") and slide.get("changed_regions") and previous_text:
+                frame = full_frame(slide)
+                images = [crop(frame, rect) for rect in slide["changed_regions"]] if frame is not None else []
+            # Детектор уже вырезал блоки текста: распознаем только их (площадь в разы меньше кадра)
+            elif slide.get("text_regions"):
+                previous_text = None
+                images = [decode(region["image_bytes"], cv2.IMREAD_UNCHANGED) for region in slide["text_regions"]]
+            else:
+                previous_text = None
+                images = [full_frame(slide)]
+
+            texts = [
+                ocr_service.extract_text(image)
+                for image in images
+                if image is not None and image.size > 0
+            ]
+            text = " ".join(t for t in [previous_text] + texts if t)
+            if len(text.strip()) > 3:
+                text_by_id[slide.get("slide_id", -1)] = text
+                results.append(
+                    {
+                        "timestamp": timestamp,
+                        "frame_index": frame_idx,
+                        "slide_id": slide.get("slide_id", -1),
+                        "ocr_text": text,
+                    }
+                )
     except Exception as e:
         worker_logger.error(f"Worker crashed: {e}")
-    finally:
-        if cap:
-            cap.release()
 
-    worker_logger.info(f"Worker finished. Found text on {len(results)} slides.")
-    return results
+    worker_logger.info(f"Worker finished. Found text on {len(results)} of {processed} slides.")
+    result_queue.put(results)
 
 
 class AnalysisService:
@@ -95,11 +136,106 @@ class AnalysisService:
         # В основном процессе живет только Whisper (Torch) и C++ детектор
         self.audio_service = AudioService(model_size="base")
         self.video_service = SlideDetectionService(
-            min_scene_duration=2.0, min_area_ratio=0.15
+            min_scene_duration=2.0,
+            min_area_ratio=0.15,
+            target_analysis_fps=settings.ANALYSIS_FPS,
+            coarse_threshold=settings.COARSE_THRESHOLD,
+            compute_backend=settings.COMPUTE_BACKEND,
+            decode_acceleration=settings.DECODE_ACCELERATION,
+            reduced_decode=settings.REDUCED_DECODE,
+            cache_dir=settings.RESULT_CACHE_DIR,
+            revisit_history=settings.REVISIT_HISTORY,
+            adaptive_threshold=settings.ADAPTIVE_THRESHOLD,
+            exclude_regions=settings.EXCLUDE_REGIONS,
+            auto_exclude_seconds=settings.AUTO_EXCLUDE_SECONDS,
+            engine_threads=settings.ENGINE_THREADS,
+            text_regions=settings.OCR_TEXT_REGIONS,
+            binarize_text=settings.OCR_BINARIZE,
+            memory_budget_mb=settings.MEMORY_BUDGET_MB,
+            spill_dir=settings.SPILL_DIR,
         )
         self.llm_service = LLMJudgeService()
 
-    def analyze_content(self, video_path: str) -> Dict[str, Any]:
+    @staticmethod
+    def _remove_spilled(slides: List[Dict]) -> None:
+        """Delete the slide images the detector spilled to disk (MEMORY_BUDGET_MB) once OCR has read them."""
+        for slide in slides:
+            path = slide.pop("image_path", None)
+            if path:
+                try:
+                    os.remove(path)
+                except OSError as e:
+                    logger.warning(f"Could not remove spilled slide {path}: {e}")
+
+    @staticmethod
+    def _wait_for_ocr(ocr_process, result_queue) -> List[Dict]:
+        """Collect the OCR worker's results; an empty list if the process died without them."""
+        visual_data = []
+        while True:
+            try:
+                visual_data = result_queue.get(timeout=5.0)
+                break
+            except queue.Empty:
+                if not ocr_process.is_alive():
+                    # It may have put its results right before exiting
+                    try:
+                        visual_data = result_queue.get(timeout=1.0)
+                    except queue.Empty:
+                        logger.error(f"OCR worker exited with code {ocr_process.exitcode}")
+                    break
+        ocr_process.join()
+        return visual_data
+
+    @staticmethod
+    def _add_revisits(
+        visual_data: List[Dict], detected_slides: List[Dict]
+    ) -> List[Dict]:
+        """Repeat the OCR text of a slide at every moment it is shown again."""
+        text_by_id = {
+            item["slide_id"]: item["ocr_text"]
+            for item in visual_data
+            if item.get("slide_id", -1) >= 0
+        }
+        revisits = [
+            {
+                "timestamp": slide["timestamp_sec"],
+                "frame_index": slide["frame_index"],
+                "slide_id": slide["slide_id"],
+                "ocr_text": text_by_id[slide["slide_id"]],
+                "revisit": True,
+            }
+            for slide in detected_slides
+            if slide.get("is_revisit") and slide.get("slide_id") in text_by_id
+        ]
+        if not revisits:
+            return visual_data
+        return sorted(visual_data + revisits, key=lambda item: item["timestamp"])
+
+    def analyze_batch(self, video_paths: List[str]) -> List[Dict[str, Any]]:
+        """
+        Analyze a queue of interviews.
+
+        Slide detection for all videos runs first, in parallel on the shared
+        native engine; audio, OCR and LLM phases then run per video.
+        """
+        logger.info("👁️ Batch slide detection for %d videos...", len(video_paths))
+        detections = self.video_service.process_videos(video_paths, with_frames=True)
+        return [
+            self.analyze_content(video_path, detection=detection)
+            for video_path, detection in zip(video_paths, detections)
+        ]
+
+    def analyze_content(
+        self, video_path: str, detection: Optional[Dict[str, Any]] = None
+    ) -> Dict[str, Any]:
+        """
+        Run the full analysis of one video.
+
+        Args:
+            video_path: Path to the video file
+            detection: Result of SlideDetectionService.process_videos(with_frames=True)
+                for this video; slide detection is skipped if it is given
+        """
         path = Path(video_path)
         if not path.exists():
             raise FileNotFoundError(f"Video not found: {video_path}")
@@ -120,30 +256,62 @@ class AnalysisService:
         except Exception as e:
             logger.error(f"Audio processing failed: {e}")
 
-        # --- Phase 2: Visual Processing (C++ Detection) ---
-        # C++ работает здесь (быстро и без конфликтов)
-        logger.info("👁️ Phase 2: Visual Processing (Detection)...")
+        # --- Phase 2+3: Visual Processing (C++ Detection) + OCR (Isolated Process) ---
+        # Paddle работает в отдельной "песочнице" и получает слайды прямо во время
+        # сканирования, так что детекция и OCR идут одновременно
+        logger.info(
+            f"👁️ Phase 2+3: Detection + OCR Extraction (Isolated, lang={detected_language})..."
+        )
+        # Используем 'spawn', чтобы процесс был чистым (без Torch в памяти)
+        ctx = multiprocessing.get_context("spawn")
+        slide_queue = ctx.Queue()
+        result_queue = ctx.Queue()
+        ocr_process = ctx.Process(
+            target=_ocr_worker_task,
+            args=(video_path, slide_queue, result_queue, detected_language),
+        )
+        ocr_process.start()
+
+        previous_slide_id = None
+
+        def send_to_ocr(slide: Dict[str, Any]) -> None:
+            # Слайд-надстройка (is_build_up) дописывает текст к предыдущему слайду
+            nonlocal previous_slide_id
+            slide = dict(slide, previous_slide_id=previous_slide_id)
+            previous_slide_id = slide.get("slide_id")
+            # Вернувшиеся слайды (is_revisit) не распознаем повторно — текст берем у первого показа
+            if not slide.get("is_revisit"):
+                slide_queue.put(slide)
+
         detected_slides = []
+        detection_stats = {}
         try:
-            detected_slides = self.video_service.process_video(video_path)
-            logger.info(f"⚡ C++ detected {len(detected_slides)} keyframes")
+            if detection is None:
+                # Кадры слайдов захватываются в том же проходе (PNG без потерь для OCR)
+                detected_slides = self.video_service.process_video_with_frames(
+                    video_path, on_slide=send_to_ocr
+                )
+                detection_stats = self.video_service.last_stats
+            elif detection["error"]:
+                raise RuntimeError(detection["error"])
+            else:
+                # Уже посчитано в analyze_batch
+                detected_slides = detection["slides"]
+                detection_stats = detection["stats"]
+                for slide in detected_slides:
+                    send_to_ocr(slide)
+            logger.info(
+                f"⚡ C++ detected {len(detected_slides)} keyframes in {detection_stats.get('wall_sec', 0.0):.1f}s "
+                f"({detection_stats.get('frames_analyzed', 0)} frames analyzed)"
+            )
         except Exception as e:
             logger.error(f"Slide detection failed: {e}")
+        finally:
+            slide_queue.put(None)
 
-        # --- Phase 3: OCR (Isolated Process) ---
-        # Запускаем Paddle в отдельной "песочнице"
-        logger.info(
-            f"📖 Phase 3: OCR Extraction (Isolated, lang={detected_language})..."
-        )
-        visual_data = []
-        if detected_slides:
-            # Используем 'spawn', чтобы процесс был чистым (без Torch в памяти)
-            ctx = multiprocessing.get_context("spawn")
-            with ctx.Pool(processes=1) as pool:
-                # Передаем путь к видео, список кадров, и detected language
-                visual_data = pool.apply(
-                    _ocr_worker_task, (video_path, detected_slides, detected_language)
-                )
+        visual_data = self._wait_for_ocr(ocr_process, result_queue)
+        self._remove_spilled(detected_slides)
+        visual_data = self._add_revisits(visual_data, detected_slides)
 
         # Собираем сырые данные
         analysis_result = {
@@ -151,6 +319,7 @@ class AnalysisService:
                 "video_path": str(video_path),
                 "status": "completed",
                 "detected_language": detected_language,
+                "detection_stats": detection_stats,
             },
             "transcription": transcript,
             "visual_context": visual_data,
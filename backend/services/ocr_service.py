@@ -101,8 +101,9 @@ class OcrService:
             return ""
 
         try:
-            # Paddle ожидает RGB
-            frame_rgb = cv2.cvtColor(frame, cv2.COLOR_BGR2RGB)
+            # Paddle ожидает RGB (бинаризованные блоки текста приходят в оттенках серого)
+            code = cv2.COLOR_GRAY2RGB if frame.ndim == 2 else cv2.COLOR_BGR2RGB
+            frame_rgb = cv2.cvtColor(frame, code)
 
             # Инференс
             result = self.ocr.ocr(frame_rgb, cls=False)
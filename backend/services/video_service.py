@@ -6,7 +6,7 @@ Handles video processing, slide detection, and frame extraction.
 
 import sys
 from pathlib import Path
-from typing import List, Optional, Dict, Any
+from typing import Any, BinaryIO, Callable, Dict, List, Optional, Tuple, Union
 import logging
 
 # Setup path for C++ module
@@ -17,6 +17,15 @@ sys.path.insert(0, str(LIBS_PATH))
 
 logger = logging.getLogger(__name__)
 
+# Early-result callbacks of process_video / process_video_with_frames
+SlideCallback = Callable[[Dict[str, Any]], None]
+ProgressCallback = Callable[[Dict[str, Any]], None]
+
+# Video input of the single-video methods: a path, the video bytes (any buffer: bytes,
+# bytearray, memoryview, numpy uint8 array; not copied) or a binary file-like object
+# such as an upload stream
+VideoInput = Union[str, Path, bytes, bytearray, memoryview, BinaryIO]
+
 
 class VideoProcessingError(Exception):
     """Raised when video processing fails."""
@@ -32,19 +41,88 @@ class SlideDetectionService:
     a clean Python interface for video processing.
     """
 
-    def __init__(self, min_scene_duration: float = 2.0, min_area_ratio: float = 0.15):
+    def __init__(
+        self,
+        min_scene_duration: float = 2.0,
+        min_area_ratio: float = 0.15,
+        target_analysis_fps: float = 0.0,
+        coarse_threshold: float = 0.0,
+        compute_backend: str = "cpu",
+        decode_acceleration: str = "none",
+        reduced_decode: bool = False,
+        cache_dir: str = "",
+        revisit_history: int = 0,
+        adaptive_threshold: float = 0.0,
+        exclude_regions: Optional[List[Tuple[float, float, float, float]]] = None,
+        auto_exclude_seconds: float = 0.0,
+        engine_threads: int = 0,
+        text_regions: bool = False,
+        binarize_text: bool = False,
+        memory_budget_mb: int = 0,
+        spill_dir: str = "",
+    ):
         """
         Initialize the slide detection service.
 
         Args:
             min_scene_duration: Minimum duration between slides (seconds)
             min_area_ratio: Minimum area ratio for slide detection (0.0-1.0)
+            target_analysis_fps: Analyze only ~N frames per second of video
+                (0 = analyze every frame)
+            coarse_threshold: Thumbnail mean-abs-diff (gray levels) below which
+                a frame is considered static and skips edge detection (0 = off)
+            compute_backend: "cpu" or "opencl" (GPU via OpenCV T-API; runs on
+                the CPU if OpenCV finds no OpenCL device)
+            decode_acceleration: Hardware video decoding: "none", "any", "vaapi",
+                "d3d11" or "mfx" (falls back to software decoding)
+            reduced_decode: Let the decoder output gray 1280px-wide frames for
+                analysis (GStreamer); full-resolution frames only for slides
+            cache_dir: Directory for cached detection results ("" = no cache).
+                Re-processing the same file with the same settings is then
+                read from disk instead of scanning the video
+            revisit_history: Remember this many distinct slides and tag a slide
+                that comes back (is_revisit, same slide_id) (0 = off)
+            adaptive_threshold: Trigger on changes this many robust standard
+                deviations above the video's own noise floor (running median /
+                MAD of the change scores) instead of min_area_ratio (0 = off)
+            exclude_regions: Frame areas to ignore, (x, y, width, height) in
+                fractions of the frame (e.g. a webcam overlay)
+            auto_exclude_seconds: Search the first N seconds of each video for a
+                moving overlay and ignore it too (0 = off)
+            engine_threads: Videos processed at once by process_videos()
+                (0 = one per CPU core)
+            text_regions: With frame capture, also cut every slide out of the
+                frame and return its text blocks ("text_regions"), so OCR only
+                reads text instead of the whole frame
+            binarize_text: Return the text blocks as black-on-white gray images
+            memory_budget_mb: Memory of one scan for decoded frames and captured
+                slides (0 = unlimited). Slides over it are written to spill_dir
+                and returned as "image_path" instead of pixels; the caller
+                deletes those files
+            spill_dir: Directory for spilled slides ("" = system temp directory)
 
         Raises:
             ImportError: If C++ module cannot be loaded
+            ValueError: If compute_backend or decode_acceleration is unknown
         """
         self.min_scene_duration = min_scene_duration
         self.min_area_ratio = min_area_ratio
+        self.target_analysis_fps = target_analysis_fps
+        self.coarse_threshold = coarse_threshold
+        self.compute_backend = compute_backend
+        self.decode_acceleration = decode_acceleration
+        self.reduced_decode = reduced_decode
+        self.cache_dir = cache_dir
+        self.revisit_history = revisit_history
+        self.adaptive_threshold = adaptive_threshold
+        self.exclude_regions = list(exclude_regions or [])
+        self.auto_exclude_seconds = auto_exclude_seconds
+        self.engine_threads = engine_threads
+        self.text_regions = text_regions
+        self.binarize_text = binarize_text
+        self.memory_budget_mb = memory_budget_mb
+        self.spill_dir = spill_dir
+        self.last_stats: Dict[str, Any] = {}
 
         try:
             import ai_interview_cpp
@@ -53,6 +131,8 @@ class SlideDetectionService:
             self._detector = ai_interview_cpp.SlideDetector(
                 min_scene_duration, min_area_ratio
             )
+            self._configure_detector(self._detector)
+            self._engine = None  # Created by the first process_videos() call
             logger.info("Slide detector initialized successfully")
         except ImportError as e:
             logger.error(f"Failed to import C++ module: {e}")
@@ -60,47 +140,333 @@ class SlideDetectionService:
                 "C++ module not found. Please build the project first using scripts/build.sh"
             ) from e
 
-    def process_video(self, video_path: str) -> List[Dict[str, Any]]:
+    def _configure_detector(self, detector) -> None:
+        """Apply the service settings to a native SlideDetector (thresholds are constructor arguments)."""
+        detector.target_analysis_fps = self.target_analysis_fps
+        detector.coarse_threshold = self.coarse_threshold
+        detector.compute_backend = self._parse_compute_backend(self.compute_backend)
+        detector.decode_acceleration = self._parse_decode_acceleration(self.decode_acceleration)
+        detector.reduced_decode = self.reduced_decode
+        detector.cache_dir = self.cache_dir
+        detector.revisit_history = self.revisit_history
+        detector.adaptive_threshold = self.adaptive_threshold
+        detector.memory_budget = int(self.memory_budget_mb) * 1024 * 1024
+        detector.spill_dir = self.spill_dir
+        for region in self.exclude_regions:
+            detector.add_exclude_region(*region)
+        detector.auto_exclude_duration = self.auto_exclude_seconds
+
+    def _parse_compute_backend(self, name: str):
+        """Map "cpu" / "opencl" to ai_interview_cpp.ComputeBackend."""
+        backends = {
+            "cpu": self._cpp_module.ComputeBackend.CPU,
+            "opencl": self._cpp_module.ComputeBackend.OPENCL,
+        }
+        if name not in backends:
+            raise ValueError(f"Unknown compute backend: {name!r} (expected 'cpu' or 'opencl')")
+
+        if name == "opencl" and not self._cpp_module.SlideDetector.is_opencl_available():
+            logger.warning("OpenCL device not found: ComputeBackend.OPENCL will run on the CPU")
+        return backends[name]
+
+    def _parse_decode_acceleration(self, name: str):
+        """Map "none" / "any" / "vaapi" / "d3d11" / "mfx" to ai_interview_cpp.DecodeAcceleration."""
+        accelerations = self._cpp_module.DecodeAcceleration.__members__
+        if name.upper() not in accelerations:
+            raise ValueError(
+                f"Unknown decode acceleration: {name!r} (expected one of {', '.join(a.lower() for a in accelerations)})"
+            )
+        return accelerations[name.upper()]
+
+    def _native_source(self, video: VideoInput):
+        """
+        Convert a video input for the C++ module: paths are checked and passed as str,
+        buffers as they are (zero-copy), file-like objects become a VideoSource
+        (a VideoSource is returned unchanged).
+
+        Raises:
+            FileNotFoundError: If video file doesn't exist
+            ValueError: If the path is not a file or the stream is empty
+        """
+        if isinstance(video, (str, Path)):
+            path = Path(video)
+            if not path.exists():
+                raise FileNotFoundError(f"Video file not found: {video}")
+            if not path.is_file():
+                raise ValueError(f"Path is not a file: {video}")
+            return str(video)
+        if isinstance(video, self._cpp_module.VideoSource):
+            return video
+        if hasattr(video, "read"):
+            return self._cpp_module.VideoSource.from_reader(video)
+        return self._cpp_module.VideoSource.from_memory(video)
+
+    @staticmethod
+    def _describe(video: VideoInput) -> str:
+        """Video input for log messages."""
+        if isinstance(video, (str, Path)):
+            return str(video)
+        if hasattr(video, "read"):
+            return "<video stream>"
+        return f"<{memoryview(video).nbytes} bytes in memory>"
+
+    def get_decode_info(self, video_path: VideoInput) -> Dict[str, Any]:
+        """
+        Report how the detector actually decodes a video.
+
+        Returns:
+            Dictionary with backend (e.g. "FFMPEG"), acceleration ("none" if
+            software), device and fallback (hardware open failed)
+        """
+        return self._decode_info(self._native_source(video_path))
+
+    def _decode_info(self, source) -> Dict[str, Any]:
+        """get_decode_info for a source already converted by _native_source (a reader is not wrapped twice)."""
+        info = self._detector.get_decode_info(source)
+        return {
+            "backend": info.backend,
+            "acceleration": info.acceleration.name.lower(),
+            "device": info.device,
+            "fallback": info.fallback,
+        }
+
+    def get_analysis_region(self, video_path: VideoInput) -> Dict[str, Any]:
+        """
+        Report which part of the frames a scan of this video analyzes.
+
+        Returns:
+            Dictionary with include (x, y, width, height) and the list of exclude
+            rectangles (configured plus auto-detected), in fractions of the frame
+        """
+        region = self._detector.detect_analysis_region(self._native_source(video_path))
+        return {"include": region.include, "exclude": region.exclude}
+
+    def _log_decode_info(self, source) -> None:
+        """Log whether hardware decoding was really used (only if it was requested)."""
+        if self.decode_acceleration == "none":
+            return
+        info = self._decode_info(source)
+        if info["acceleration"] == "none":
+            logger.warning(f"Hardware decoding unavailable, using software ({info['backend']})")
+        else:
+            logger.info(f"Decoding with {info['backend']} / {info['acceleration']} (device {info['device']})")
+
+    def _stats_to_dict(self, stats) -> Dict[str, Any]:
+        """
+        Convert ai_interview_cpp.ScanStats to a plain dictionary (e.g. for a metrics exporter).
+
+        Stage histograms are cumulative like Prometheus buckets: {"le": bound, "count": n}.
+        """
+        bounds = self._cpp_module.StageStats.bucket_bounds_sec()
+        stages = {}
+        for name, stage in stats.stages.items():
+            cumulative = 0
+            buckets = []
+            for bound, count in zip(bounds, stage.histogram):
+                cumulative += count
+                buckets.append({"le": bound, "count": cumulative})
+            stages[name] = {
+                "count": stage.count,
+                "total_sec": stage.total_sec,
+                "max_sec": stage.max_sec,
+                "mean_sec": stage.mean_sec,
+                "buckets": buckets,
+            }
+
+        return {
+            "frames_decoded": stats.frames_decoded,
+            "frames_skipped": stats.frames_skipped,
+            "frames_analyzed": stats.frames_analyzed,
+            "frames_static": stats.frames_static,
+            "slides": stats.slides,
+            "cache_hit": stats.cache_hit,
+            "wall_sec": stats.wall_sec,
+            "start_rss_bytes": stats.start_rss_bytes,
+            "peak_rss_bytes": stats.peak_rss_bytes,
+            "stages": stages,
+        }
+
+    @staticmethod
+    def _segment_to_dict(seg) -> Dict[str, Any]:
+        """Convert ai_interview_cpp.SlideSegment to a dictionary."""
+        return {
+            "frame_index": seg.frame_index,
+            "timestamp_sec": seg.timestamp_sec,
+            "change_ratio": seg.change_ratio,
+            "slide_id": seg.slide_id,
+            "is_revisit": seg.is_revisit,
+            "changed_regions": seg.changed_regions,
+            "is_build_up": seg.is_build_up,
+        }
+
+    @classmethod
+    def _captured_slide_to_dict(cls, slide, encoding: str) -> Dict[str, Any]:
         """
-        Process a video file to detect slide transitions.
+        Convert ai_interview_cpp.CapturedSlide to a segment dictionary with its image.
+
+        Text blocks, if any were found, are added as "text_regions": a list of
+        {"rect": (x, y, width, height), "image" / "image_bytes"} in reading order.
+        A slide spilled over the memory budget has "image_path" instead of its image.
+        """
+        item = cls._segment_to_dict(slide.segment)
+        image_key = "image_bytes" if encoding else "image"
+        if slide.spill_path:
+            item["image_path"] = slide.spill_path
+        else:
+            item[image_key] = slide.encoded if encoding else slide.frame
+        if slide.text_regions:
+            item["text_regions"] = [
+                {"rect": region.rect, image_key: region.encoded if encoding else region.image}
+                for region in slide.text_regions
+            ]
+        return item
+
+    def _text_region_options(self):
+        """ai_interview_cpp.TextRegionOptions for frame capture (None = no text regions)."""
+        if not self.text_regions:
+            return None
+        return self._cpp_module.TextRegionOptions(binarize=self.binarize_text)
+
+    @staticmethod
+    def _progress_to_dict(progress) -> Dict[str, Any]:
+        """Convert ai_interview_cpp.ScanProgress to a dictionary."""
+        return {
+            "frames_processed": progress.frames_processed,
+            "total_frames": progress.total_frames,
+            "fraction": progress.fraction,
+            "done": progress.done,
+        }
+
+    def _progress_callback(self, on_progress: Optional[ProgressCallback]):
+        """Wrap a dict-based progress callback for the native scan (None stays None)."""
+        if on_progress is None:
+            return None
+        return lambda progress: on_progress(self._progress_to_dict(progress))
+
+    def process_video(
+        self,
+        video_path: VideoInput,
+        on_slide: Optional[SlideCallback] = None,
+        on_progress: Optional[ProgressCallback] = None,
+    ) -> List[Dict[str, Any]]:
+        """
+        Process a video to detect slide transitions.
 
         Args:
-            video_path: Path to the video file
+            video_path: Path to the video file, or the video itself (see VideoInput):
+                bytes are decoded from memory without a temporary file
+            on_slide: Called with each slide dictionary as soon as it is final,
+                while the scan continues (on a native thread; keep it short)
+            on_progress: Called about twice a second with {"frames_processed",
+                "total_frames", "fraction", "done"}, and once at the end
+
+        Frame counters and per-stage timings of the call are kept in self.last_stats.
 
         Returns:
             List of dictionaries containing slide information:
             - frame_index: Frame number where slide appears
             - timestamp_sec: Timestamp in seconds
             - change_ratio: Change ratio compared to previous slide
+            - slide_id: Distinct slide number (a revisit repeats the id)
+            - is_revisit: True if an earlier slide is shown again
+            - changed_regions: What changed since the previous slide, (x, y, width,
+              height) in fractions of the frame (empty for the first slide)
+            - is_build_up: True if the previous slide is still shown with content
+              added (bullet reveal): only changed_regions is new
 
         Raises:
             VideoProcessingError: If video processing fails
             FileNotFoundError: If video file doesn't exist
         """
-        video_path_obj = Path(video_path)
-        if not video_path_obj.exists():
-            raise FileNotFoundError(f"Video file not found: {video_path}")
+        try:
+            source = self._native_source(video_path)
+            logger.info(f"Processing video: {self._describe(video_path)}")
+            self._log_decode_info(source)
+            stats = self._cpp_module.ScanStats()
+            on_segment = None
+            if on_slide is not None:
+                on_segment = lambda seg: on_slide(self._segment_to_dict(seg))
+            segments = self._detector.process_video(
+                source,
+                stats=stats,
+                on_segment=on_segment,
+                on_progress=self._progress_callback(on_progress),
+            )
+            self.last_stats = self._stats_to_dict(stats)
+
+            # Convert C++ objects to dictionaries
+            result = [self._segment_to_dict(seg) for seg in segments]
+
+            logger.info(f"Detected {len(result)} slides in video")
+            return result
+
+        except FileNotFoundError:
+            raise
+        except RuntimeError as e:
+            logger.error(f"C++ processing error: {e}")
+            raise VideoProcessingError(f"Failed to process video: {e}") from e
+        except Exception as e:
+            logger.error(f"Unexpected error during video processing: {e}")
+            raise VideoProcessingError(f"Unexpected error: {e}") from e
+
+    def process_video_with_frames(
+        self,
+        video_path: VideoInput,
+        max_width: int = 0,
+        encoding: str = ".png",
+        on_slide: Optional[SlideCallback] = None,
+        on_progress: Optional[ProgressCallback] = None,
+    ) -> List[Dict[str, Any]]:
+        """
+        Detect slide transitions and capture each slide image in the same pass.
 
-        if not video_path_obj.is_file():
-            raise ValueError(f"Path is not a file: {video_path}")
+        Avoids decoding the slide frames a second time via get_frame/get_frames.
 
+        Args:
+            video_path: Path to the video file or the video itself, as in process_video()
+            max_width: Downscale captured images wider than this (0 = full resolution)
+            encoding: Image encoding (".png", ".jpg") or "" for raw numpy arrays
+            on_slide: Called with each slide dictionary (with its image) as soon
+                as it is final, e.g. to start OCR while the scan continues
+            on_progress: Same as in process_video()
+
+        Returns:
+            Same dictionaries as process_video(), plus:
+            - image: numpy array (BGR) when encoding is ""
+            - image_bytes: encoded image otherwise
+            - text_regions: Text blocks of the slide, if text_regions is on and
+              any were found: [{"rect": (x, y, w, h), "image" / "image_bytes"}]
+
+        Raises:
+            VideoProcessingError: If video processing fails
+            FileNotFoundError: If video file doesn't exist
+        """
         try:
-            logger.info(f"Processing video: {video_path}")
-            segments = self._detector.process_video(str(video_path))
+            source = self._native_source(video_path)
+            logger.info(f"Processing video with frame capture: {self._describe(video_path)}")
+            self._log_decode_info(source)
+            stats = self._cpp_module.ScanStats()
+            on_captured = None
+            if on_slide is not None:
+                on_captured = lambda slide: on_slide(self._captured_slide_to_dict(slide, encoding))
+            slides = self._detector.process_video_with_frames(
+                source,
+                max_width=max_width,
+                encoding=encoding,
+                text_regions=self._text_region_options(),
+                stats=stats,
+                on_slide=on_captured,
+                on_progress=self._progress_callback(on_progress),
+            )
+            self.last_stats = self._stats_to_dict(stats)
 
-            # Convert C++ objects to dictionaries
-            result = [
-                {
-                    "frame_index": seg.frame_index,
-                    "timestamp_sec": seg.timestamp_sec,
-                    "change_ratio": seg.change_ratio,
-                }
-                for seg in segments
-            ]
+            result = [self._captured_slide_to_dict(slide, encoding) for slide in slides]
 
             logger.info(f"Detected {len(result)} slides in video")
             return result
 
+        except FileNotFoundError:
+            raise
         except RuntimeError as e:
             logger.error(f"C++ processing error: {e}")
             raise VideoProcessingError(f"Failed to process video: {e}") from e
@@ -108,12 +474,147 @@ class SlideDetectionService:
             logger.error(f"Unexpected error during video processing: {e}")
             raise VideoProcessingError(f"Unexpected error: {e}") from e
 
-    def get_frame(self, video_path: str, frame_index: int):
+    def _get_engine(self):
+        """Native batch engine with this service's settings (created on first use)."""
+        if self._engine is None:
+            self._engine = self._cpp_module.SlideDetectionEngine(
+                self.engine_threads, self.min_scene_duration, self.min_area_ratio
+            )
+            self._configure_detector(self._engine.detector)
+            logger.info(f"Slide detection engine started with {self._engine.num_threads} workers")
+        return self._engine
+
+    def process_videos(
+        self,
+        video_paths: List[str],
+        with_frames: bool = False,
+        max_width: int = 0,
+        encoding: str = ".png",
+        on_result: Optional[Callable[[Dict[str, Any]], None]] = None,
+    ) -> List[Dict[str, Any]]:
         """
-        Extract a specific frame from a video.
+        Detect slides in many videos at once on one shared native worker pool.
+
+        Videos are scanned in parallel (largest first) inside this process,
+        without a new process or detector per video. A failing video doesn't
+        stop the batch: its entry has "error" set.
+
+        Args:
+            video_paths: Paths to the video files
+            with_frames: Capture slide images like process_video_with_frames()
+            max_width: Downscale captured images wider than this (0 = full resolution)
+            encoding: Image encoding (".png", ".jpg") or "" for raw numpy arrays
+            on_result: Called with each video's entry as soon as it is done
+                (on a native worker thread)
+
+        Returns:
+            One dictionary per path, in the same order:
+            - video_path: Path of the video
+            - slides: Same dictionaries as process_video() / process_video_with_frames()
+            - stats: Frame counters and stage timings (see last_stats)
+            - error: Error message, or None on success
+        """
+        engine = self._get_engine()
+
+        def to_dict(video) -> Dict[str, Any]:
+            if with_frames:
+                slides = [self._captured_slide_to_dict(s, encoding) for s in video.slides]
+            else:
+                slides = [self._segment_to_dict(seg) for seg in video.segments]
+            return {
+                "video_path": video.video_path,
+                "slides": slides,
+                "stats": self._stats_to_dict(video.stats),
+                "error": None if video.ok else video.error,
+            }
+
+        callback = None
+        if on_result is not None:
+            callback = lambda video: on_result(to_dict(video))
+
+        logger.info(f"Processing batch of {len(video_paths)} videos")
+        paths = [str(path) for path in video_paths]
+        if with_frames:
+            videos = engine.process_videos_with_frames(
+                paths,
+                max_width=max_width,
+                encoding=encoding,
+                text_regions=self._text_region_options(),
+                callback=callback,
+            )
+        else:
+            videos = engine.process_videos(paths, callback=callback)
+
+        results = [to_dict(video) for video in videos]
+        for item in results:
+            if item["error"]:
+                logger.error(f"Slide detection failed for {item['video_path']}: {item['error']}")
+        return results
+
+    def build_signal_index(self, video_path: str, index_path: str) -> int:
+        """
+        Decode the video once and save its per-frame change signal.
+
+        The index lets reselect_slides() try other thresholds without
+        decoding the video again (e.g. for an interactive threshold slider).
 
         Args:
             video_path: Path to the video file
+            index_path: Where to write the index file
+
+        Returns:
+            Number of recorded (sampled) frames
+
+        Raises:
+            VideoProcessingError: If video processing fails
+            FileNotFoundError: If video file doesn't exist
+        """
+        if not Path(video_path).is_file():
+            raise FileNotFoundError(f"Video file not found: {video_path}")
+
+        try:
+            index = self._detector.build_signal_index(str(video_path))
+            self._cpp_module.save_signal_index(str(index_path), index)
+            logger.info(f"Signal index with {len(index)} frames saved to {index_path}")
+            return len(index)
+
+        except RuntimeError as e:
+            logger.error(f"C++ processing error: {e}")
+            raise VideoProcessingError(f"Failed to build signal index: {e}") from e
+        except Exception as e:
+            logger.error(f"Unexpected error while building the signal index: {e}")
+            raise VideoProcessingError(f"Unexpected error: {e}") from e
+
+    def reselect_slides(
+        self, index_path: str, min_scene_duration: float, min_area_ratio: float
+    ) -> List[Dict[str, Any]]:
+        """
+        Re-run slide selection on a saved signal index for other thresholds.
+
+        No decoding. For a fixed-threshold scan the thresholds the index was
+        recorded with select the same frames (frame_index / timestamp) as
+        process_video(); others are estimated from the stored edge occupancy.
+        The adaptive threshold is not replayed, slide_id is the slide number
+        (no revisit tracking), changed_regions stays empty and is_build_up
+        False.
+
+        Returns:
+            Same dictionaries as process_video()
+        """
+        try:
+            index = self._cpp_module.load_signal_index(str(index_path))
+            segments = self._cpp_module.select_segments(index, min_scene_duration, min_area_ratio)
+        except RuntimeError as e:
+            raise VideoProcessingError(f"Failed to read signal index: {e}") from e
+
+        return [self._segment_to_dict(seg) for seg in segments]
+
+    def get_frame(self, video_path: VideoInput, frame_index: int):
+        """
+        Extract a specific frame from a video.
+
+        Args:
+            video_path: Path to the video file or the video itself (see VideoInput)
             frame_index: Index of the frame to extract
 
         Returns:
@@ -123,7 +624,7 @@ class SlideDetectionService:
             VideoProcessingError: If frame extraction fails
         """
         try:
-            frame = self._detector.get_frame(video_path, frame_index)
+            frame = self._detector.get_frame(self._native_source(video_path), frame_index)
             if frame is None or frame.size == 0:
                 raise VideoProcessingError(f"Failed to extract frame {frame_index}")
             return frame
@@ -131,6 +632,97 @@ class SlideDetectionService:
             logger.error(f"Failed to extract frame: {e}")
             raise VideoProcessingError(f"Frame extraction failed: {e}") from e
 
+    def get_frames(self, video_path: VideoInput, frame_indices: List[int]) -> List[Any]:
+        """
+        Extract several frames from a video in a single pass.
+
+        The C++ module opens the video once and decodes forward, which is much
+        cheaper than calling get_frame() for every slide.
+
+        Args:
+            video_path: Path to the video file or the video itself (see VideoInput)
+            frame_indices: Indices of the frames to extract (any order)
+
+        Returns:
+            List of numpy arrays (BGR format) in the same order as frame_indices.
+            Frames that could not be read are empty arrays.
+
+        Raises:
+            VideoProcessingError: If the video cannot be opened
+        """
+        try:
+            return self._detector.get_frames(self._native_source(video_path), list(frame_indices))
+        except Exception as e:
+            logger.error(f"Failed to extract frames: {e}")
+            raise VideoProcessingError(f"Frame extraction failed: {e}") from e
+
+    def make_thumbnails(
+        self,
+        video_path: VideoInput,
+        frame_indices: List[int],
+        width: int = 320,
+        encoding: str = ".jpg",
+        quality: int = 80,
+        sprite_sheet: bool = False,
+        sprite_columns: int = 5,
+        output_dir: str = "",
+    ) -> Dict[str, Any]:
+        """
+        Build small slide previews natively, in one decode pass.
+
+        Frames are downscaled and encoded on all cores while the video is
+        decoded, so no full-resolution frame reaches Python.
+
+        Args:
+            video_path: Path to the video file or the video itself (see VideoInput)
+            frame_indices: Frames to preview (e.g. the frame_index of every slide)
+            width: Thumbnail width in pixels (aspect ratio kept, never upscaled)
+            encoding: ".jpg", ".webp" or ".png"
+            quality: JPEG / WebP quality (1-100)
+            sprite_sheet: Also tile all thumbnails into one image
+            sprite_columns: Thumbnails per sprite sheet row
+            output_dir: Write the images there and return paths instead of bytes
+
+        Returns:
+            Dictionary with:
+            - thumbnails: [{"frame_index", "image_bytes" or "path"}] in the order
+              of frame_indices (None for frames that could not be read)
+            - sprite: {"image_bytes" or "path", "columns", "tile_size"} or None
+
+        Raises:
+            VideoProcessingError: If the video cannot be opened or an image
+                cannot be encoded / written
+        """
+        try:
+            result = self._detector.make_thumbnails(
+                self._native_source(video_path),
+                list(frame_indices),
+                width=width,
+                encoding=encoding,
+                quality=quality,
+                sprite_sheet=sprite_sheet,
+                sprite_columns=sprite_columns,
+                output_dir=str(output_dir),
+            )
+        except (RuntimeError, ValueError) as e:
+            logger.error(f"Failed to build thumbnails: {e}")
+            raise VideoProcessingError(f"Thumbnail generation failed: {e}") from e
+
+        def image(data: bytes, path: str) -> Optional[Dict[str, Any]]:
+            if path:
+                return {"path": path}
+            return {"image_bytes": data} if data else None
+
+        thumbnails = []
+        for thumb in result.thumbnails:
+            item = image(thumb.encoded, thumb.path)
+            thumbnails.append(dict(item, frame_index=thumb.frame_index) if item else None)
+
+        sprite = image(result.sprite, result.sprite_path)
+        if sprite:
+            sprite.update(columns=result.sprite_columns, tile_size=result.tile_size)
+        return {"thumbnails": thumbnails, "sprite": sprite}
+
     def get_configuration(self) -> Dict[str, Any]:
         """
         Get current detector configuration.
@@ -141,4 +733,20 @@ class SlideDetectionService:
         return {
             "min_scene_duration": self.min_scene_duration,
             "min_area_ratio": self.min_area_ratio,
+            "target_analysis_fps": self.target_analysis_fps,
+            "coarse_threshold": self.coarse_threshold,
+            "compute_backend": self.compute_backend,
+            "decode_acceleration": self.decode_acceleration,
+            "reduced_decode": self.reduced_decode,
+            "cache_dir": self.cache_dir,
+            "revisit_history": self.revisit_history,
+            "adaptive_threshold": self.adaptive_threshold,
+            "exclude_regions": self.exclude_regions,
+            "auto_exclude_seconds": self.auto_exclude_seconds,
+            "engine_threads": self.engine_threads,
+            "text_regions": self.text_regions,
+            "binarize_text": self.binarize_text,
+            "memory_budget_mb": self.memory_budget_mb,
+            "spill_dir": self.spill_dir,
+            "analysis_kernel": self._detector.analysis_kernel,
         }
@@ -0,0 +1,257 @@
+#include <benchmark/benchmark.h>
+#include "ai_interview/change_metrics.hpp"
+#include "ai_interview/slide_detector.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+// Benchmarks of the slide detection core.
+//
+//   Per stage (720p / 1080p / 4K input): resize, edge map, change metrics.
+//   End to end: process_video frames/sec on synthetic clips (written once to the temp directory)
+//   and on real recordings listed in AI_INTERVIEW_BENCH_VIDEOS (paths separated by ':').
+//
+// JSON for comparing commits:
+//   ./slide_detector_benchmark --benchmark_out=bench.json --benchmark_out_format=json
+//   python3 <build>/_deps/googlebenchmark-src/tools/compare.py benchmarks old.json new.json
+
+namespace
+{
+    constexpr double SYNTHETIC_FPS = 30.0;
+    constexpr double SYNTHETIC_DURATION_SEC = 6.0;
+    constexpr double SYNTHETIC_SLIDE_SEC = 2.0; // A new slide every 2 seconds
+
+    cv::Size resolution(int64_t height)
+    {
+        return cv::Size(static_cast<int>(height * 16 / 9), static_cast<int>(height));
+    }
+
+    // Slide-like frame: light background, title bar, text lines and a chart box.
+    // Different variants change the text and the layout, so their edge maps differ.
+    cv::Mat make_slide(cv::Size size, int variant)
+    {
+        cv::Mat slide(size, CV_8UC3, cv::Scalar(245, 245, 245));
+        const double s = size.width / 1280.0;
+        std::mt19937 rng(static_cast<unsigned>(variant));
+        std::uniform_int_distribution<int> word_length(2, 9);
+        std::uniform_int_distribution<int> letter('a', 'z');
+
+        cv::rectangle(slide, cv::Rect(cvRound(60 * s), cvRound(40 * s), cvRound(1160 * s), cvRound(80 * s)),
+                      cv::Scalar(90, 60, 30), cv::FILLED);
+        cv::putText(slide, "Slide " + std::to_string(variant), cv::Point(cvRound(80 * s), cvRound(100 * s)),
+                    cv::FONT_HERSHEY_SIMPLEX, 1.6 * s, cv::Scalar(255, 255, 255), std::max(1, cvRound(3 * s)));
+
+        const int lines = 6 + variant % 5;
+        for (int line = 0; line < lines; line++)
+        {
+            std::string text = "- ";
+            for (int word = 0; word < 6; word++)
+            {
+                for (int i = word_length(rng); i > 0; i--)
+                    text += static_cast<char>(letter(rng));
+                text += ' ';
+            }
+            cv::putText(slide, text, cv::Point(cvRound(90 * s), cvRound((170 + line * 48) * s)),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.9 * s, cv::Scalar(30, 30, 30), std::max(1, cvRound(2 * s)));
+        }
+
+        const int box_x = 760 + (variant % 3) * 60;
+        cv::rectangle(slide, cv::Rect(cvRound(box_x * s), cvRound(200 * s), cvRound(380 * s), cvRound(300 * s)),
+                      cv::Scalar(40, 120, 200), std::max(1, cvRound(3 * s)));
+        return slide;
+    }
+
+    // Synthetic clip of the given height (MJPG), written on first use and reused afterwards
+    std::string synthetic_clip(int64_t height)
+    {
+        static std::map<int64_t, std::string> clips;
+        auto it = clips.find(height);
+        if (it != clips.end())
+            return it->second;
+
+        const cv::Size size = resolution(height);
+        const std::string path =
+            (std::filesystem::temp_directory_path() / ("ai_interview_bench_" + std::to_string(height) + "p.avi")).string();
+
+        cv::VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), SYNTHETIC_FPS, size);
+        if (!writer.isOpened())
+            return clips[height] = "";
+
+        const int total_frames = static_cast<int>(SYNTHETIC_DURATION_SEC * SYNTHETIC_FPS);
+        const int frames_per_slide = static_cast<int>(SYNTHETIC_SLIDE_SEC * SYNTHETIC_FPS);
+        cv::Mat slide, frame;
+        for (int i = 0; i < total_frames; i++)
+        {
+            if (i % frames_per_slide == 0)
+                slide = make_slide(size, i / frames_per_slide);
+
+            // A moving pointer keeps most frames from being bit-identical
+            slide.copyTo(frame);
+            const int x = (i * 7) % std::max(1, size.width - 40);
+            cv::rectangle(frame, cv::Rect(x, size.height / 2, 24, 24), cv::Scalar(0, 0, 255), cv::FILLED);
+            writer.write(frame);
+        }
+        writer.release();
+        return clips[height] = path;
+    }
+
+    // --- Per-stage microbenchmarks ---
+
+    void BM_Resize(benchmark::State &state)
+    {
+        const cv::Mat frame = make_slide(resolution(state.range(0)), 0);
+        ai_interview::SlideDetector detector;
+        ai_interview::SlideDetector::StageBuffers buffers;
+
+        for (auto _ : state)
+        {
+            cv::Mat resized = detector.resize_frame(frame, buffers);
+            benchmark::DoNotOptimize(resized.data);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Resize)->ArgName("height")->Arg(720)->Arg(1080)->Arg(2160);
+
+    void BM_EdgeMap(benchmark::State &state)
+    {
+        ai_interview::SlideDetector detector;
+        ai_interview::SlideDetector::StageBuffers buffers;
+        const cv::Mat input = detector.resize_frame(make_slide(resolution(state.range(0)), 0), buffers).clone();
+
+        cv::Mat edges;
+        for (auto _ : state)
+        {
+            detector.edge_map(input, edges, buffers);
+            benchmark::DoNotOptimize(edges.data);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_EdgeMap)->ArgName("height")->Arg(720)->Arg(1080)->Arg(2160);
+
+    void BM_ChangeMetric(benchmark::State &state)
+    {
+        const cv::Size size = resolution(state.range(0));
+        const auto metric = static_cast<ai_interview::ChangeMetric>(state.range(1));
+
+        ai_interview::SlideDetector detector;
+        detector.set_change_metric(metric);
+        ai_interview::SlideDetector::StageBuffers buffers;
+
+        cv::Mat edges1, edges2;
+        detector.edge_map(detector.resize_frame(make_slide(size, 0), buffers).clone(), edges1, buffers);
+        detector.edge_map(detector.resize_frame(make_slide(size, 1), buffers).clone(), edges2, buffers);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(detector.change_ratio(edges1, edges2, buffers));
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(metric == ai_interview::ChangeMetric::Contours ? "contours" : "tiles");
+    }
+    BENCHMARK(BM_ChangeMetric)
+        ->ArgNames({"height", "metric"})
+        ->ArgsProduct({{720, 1080, 2160},
+                       {static_cast<int64_t>(ai_interview::ChangeMetric::Contours),
+                        static_cast<int64_t>(ai_interview::ChangeMetric::Tiles)}});
+
+    // PackedTiles in the steady state: the reference is packed once per slide, the frame once per frame
+    void BM_PackedTileRatio(benchmark::State &state)
+    {
+        const cv::Size size = resolution(state.range(0));
+        ai_interview::SlideDetector detector;
+        ai_interview::SlideDetector::StageBuffers buffers;
+
+        cv::Mat edges1, edges2;
+        detector.edge_map(detector.resize_frame(make_slide(size, 0), buffers).clone(), edges1, buffers);
+        detector.edge_map(detector.resize_frame(make_slide(size, 1), buffers).clone(), edges2, buffers);
+
+        ai_interview::PackedEdges reference, packed;
+        ai_interview::pack_edges(edges1, reference);
+        std::vector<int> tile_counts;
+
+        for (auto _ : state)
+        {
+            ai_interview::pack_edges(edges2, packed);
+            benchmark::DoNotOptimize(ai_interview::packed_tile_change_ratio(reference, packed, tile_counts));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_PackedTileRatio)->ArgName("height")->Arg(720)->Arg(1080)->Arg(2160);
+
+    // --- End to end ---
+
+    // Runs process_video and reports decoded frames / second of wall time
+    void run_process_video(benchmark::State &state, const std::string &path, int num_threads)
+    {
+        ai_interview::SlideDetector detector;
+        detector.set_num_threads(num_threads);
+
+        uint64_t frames = 0;
+        uint64_t slides = 0;
+        for (auto _ : state)
+        {
+            ai_interview::ScanStats stats;
+            detector.process_video(path, &stats);
+            frames += stats.frames_decoded;
+            slides = stats.slides;
+        }
+
+        state.counters["frames_per_second"] = benchmark::Counter(static_cast<double>(frames), benchmark::Counter::kIsRate);
+        state.counters["slides"] = static_cast<double>(slides);
+    }
+
+    void BM_ProcessVideoSynthetic(benchmark::State &state)
+    {
+        const std::string path = synthetic_clip(state.range(0));
+        if (path.empty())
+        {
+            state.SkipWithError("cv::VideoWriter could not write the synthetic MJPG clip");
+            return;
+        }
+        run_process_video(state, path, static_cast<int>(state.range(1)));
+    }
+    BENCHMARK(BM_ProcessVideoSynthetic)
+        ->ArgNames({"height", "threads"})
+        ->ArgsProduct({{720, 1080, 2160}, {1, 0}})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    // One benchmark per real recording in AI_INTERVIEW_BENCH_VIDEOS
+    void register_clip_benchmarks()
+    {
+        const char *list = std::getenv("AI_INTERVIEW_BENCH_VIDEOS");
+        if (!list)
+            return;
+
+        std::stringstream paths(list);
+        std::string path;
+        while (std::getline(paths, path, ':'))
+        {
+            if (path.empty())
+                continue;
+
+            const std::string name = "BM_ProcessVideoFile/" + std::filesystem::path(path).filename().string();
+            for (int threads : {1, 0})
+            {
+                benchmark::RegisterBenchmark((name + "/threads:" + std::to_string(threads)).c_str(),
+                                             [path, threads](benchmark::State &state)
+                                             { run_process_video(state, path, threads); })
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    register_clip_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
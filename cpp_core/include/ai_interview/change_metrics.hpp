@@ -0,0 +1,74 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ai_interview
+{
+    // Tile metric configuration
+    constexpr int CHANGE_TILE_SIZE = 16;        // Tiles are 16x16 pixels
+    constexpr int CHANGE_TILE_MIN_PIXELS = 16;  // A full tile is "dirty" if at least this many pixels changed
+
+    /**
+     * @brief Fused change metric: fraction of "dirty" tiles between two edge maps.
+     * One pass over both images: XOR 8 pixels at a time, count the changed pixels per
+     * CHANGE_TILE_SIZE tile and compare with CHANGE_TILE_MIN_PIXELS (scaled for border tiles).
+     * No diff image, no contours, no overlap double-counting.
+     * @param edges1, edges2 CV_8UC1 edge maps of the same size.
+     * @param tile_counts Scratch buffer (one counter per tile column), resized as needed.
+     * @return Fraction of dirty tiles (0.0 - 1.0). 1.0 if one of the maps is empty.
+     */
+    double tile_change_ratio(const cv::Mat &edges1, const cv::Mat &edges2, std::vector<int> &tile_counts);
+
+    /**
+     * @brief 1-bit edge map: bit (x % 64) of word (x / 64) in a row is set if pixel x is an edge.
+     * 8x smaller than the CV_8U map (1280x720 -> ~115 KB), cheap to compare and to keep around.
+     * Padding bits at the end of each row are always 0.
+     */
+    struct PackedEdges
+    {
+        int rows = 0;
+        int cols = 0;
+        int words_per_row = 0;
+        std::vector<uint64_t> bits;
+
+        bool empty() const { return bits.empty(); }
+        size_t bytes() const { return bits.size() * sizeof(uint64_t); }
+        const uint64_t *row(int y) const { return bits.data() + static_cast<size_t>(y) * words_per_row; }
+        uint64_t *row(int y) { return bits.data() + static_cast<size_t>(y) * words_per_row; }
+    };
+
+    /**
+     * @brief Pack a CV_8UC1 edge map (any non-zero pixel = edge). Reuses the buffer of `packed`.
+     */
+    void pack_edges(const cv::Mat &edges, PackedEdges &packed);
+
+    /**
+     * @brief 3x3 rectangular dilation of a packed map, in place: each row ORs its words shifted by one
+     * bit both ways (carrying across words), then each row ORs the rows above and below.
+     * Same result as pack_edges(cv::dilate(edges, 3x3 rect)), 64 pixels per operation.
+     * @param rows Scratch buffer (two rows), resized as needed.
+     */
+    void dilate_packed_edges(PackedEdges &packed, std::vector<uint64_t> &rows);
+
+    /**
+     * @brief Clear the pixels of `rect` (inside the map), a word at a time.
+     * Same result as packing the 8-bit map after edges(rect).setTo(0).
+     */
+    void clear_packed_rect(PackedEdges &packed, const cv::Rect &rect);
+
+    /**
+     * @brief Inverse of pack_edges: 0/255 CV_8UC1 map. Reuses the buffer of `edges`.
+     */
+    void unpack_edges(const PackedEdges &packed, cv::Mat &edges);
+
+    /**
+     * @brief Same metric as tile_change_ratio, computed on packed maps with XOR + popcount
+     * (a 64-bit word covers 4 tiles of one row). Gives the same result as tile_change_ratio
+     * on the unpacked 0/255 maps.
+     */
+    double packed_tile_change_ratio(const PackedEdges &edges1, const PackedEdges &edges2, std::vector<int> &tile_counts);
+
+} // namespace ai_interview
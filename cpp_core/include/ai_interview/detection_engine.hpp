@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ai_interview/slide_detector.hpp"
+#include "ai_interview/thread_pool.hpp"
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace ai_interview
+{
+    /**
+     * @brief Outcome of one video processed by SlideDetectionEngine.
+     */
+    struct VideoResult
+    {
+        std::string video_path;
+        std::vector<SlideSegment> segments;
+        std::vector<CapturedSlide> slides; // Only for videos submitted with frame capture
+        ScanStats stats;
+        std::string error; // Empty on success, otherwise what() of the exception the scan threw
+
+        bool ok() const { return error.empty(); }
+    };
+
+    /**
+     * @brief Long-lived batch processor: schedules many videos on one work-stealing pool.
+     * Every worker scans one video at a time with the shared detector (serial scan by default),
+     * so a queue of interviews keeps all cores busy without a process or detector per video.
+     * Configure detector() before submitting; it must not change while videos are queued.
+     */
+    class SlideDetectionEngine
+    {
+    public:
+        // Called on the worker thread when a video is done, before its future becomes ready
+        using ResultCallback = std::function<void(const VideoResult &)>;
+
+        /**
+         * @param num_threads Number of videos processed at once (0 = hardware concurrency).
+         * @param min_scene_duration_sec, min_area_ratio Detector thresholds (see SlideDetector).
+         */
+        explicit SlideDetectionEngine(int num_threads = 0,
+                                      double min_scene_duration_sec = DEFAULT_MIN_SCENE_DURATION,
+                                      double min_area_ratio = DEFAULT_MIN_AREA_RATIO);
+
+        // Finishes the queued videos before returning
+        ~SlideDetectionEngine() = default;
+
+        /**
+         * @brief Detector settings used for every video. Its num_threads is set to 1: the engine
+         * parallelizes across videos. Raise it only for batches smaller than the pool.
+         */
+        SlideDetector &detector() { return detector_; }
+        const SlideDetector &detector() const { return detector_; }
+
+        int get_num_threads() const { return pool_.size(); }
+
+        /**
+         * @brief Queue a video for process_video.
+         * A failed scan is reported in VideoResult::error. If on_done throws, the future holds
+         * that exception instead of the result.
+         */
+        std::future<VideoResult> submit(const std::string &video_path, ResultCallback on_done = nullptr);
+
+        /**
+         * @brief Queue a video for process_video_with_frames.
+         */
+        std::future<VideoResult> submit_with_frames(const std::string &video_path,
+                                                    const FrameCaptureOptions &options = FrameCaptureOptions(),
+                                                    ResultCallback on_done = nullptr);
+
+        /**
+         * @brief Process a batch and wait for it. Largest files are started first, so a long video
+         * doesn't start last and finish long after the rest (on_done sees them in completion order).
+         * @return One result per path, in the order of video_paths.
+         */
+        std::vector<VideoResult> process_videos(const std::vector<std::string> &video_paths,
+                                                ResultCallback on_done = nullptr);
+
+        /**
+         * @brief Same as process_videos, with frame capture.
+         */
+        std::vector<VideoResult> process_videos_with_frames(const std::vector<std::string> &video_paths,
+                                                            const FrameCaptureOptions &options = FrameCaptureOptions(),
+                                                            ResultCallback on_done = nullptr);
+
+        /**
+         * @brief Block until every submitted video is done.
+         */
+        void wait_idle() { pool_.wait_idle(); }
+
+    private:
+        std::future<VideoResult> enqueue(const std::string &video_path, bool capture_frames,
+                                         const FrameCaptureOptions &options, ResultCallback on_done);
+
+        std::vector<VideoResult> run_batch(const std::vector<std::string> &video_paths, bool capture_frames,
+                                           const FrameCaptureOptions &options, const ResultCallback &on_done);
+
+        SlideDetector detector_;
+        ThreadPool pool_; // Declared last: joined before detector_ is destroyed
+    };
+
+} // namespace ai_interview
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace ai_interview
+{
+    // Adaptive trigger threshold (SlideDetector::set_adaptive_threshold)
+    constexpr int ADAPTIVE_WARMUP_FRAMES = 30;     // Scored frames before the adaptive threshold replaces min_area_ratio
+    constexpr double ADAPTIVE_MIN_RATIO = 0.05;    // Clamp of the adaptive threshold: clean videos still ignore
+    constexpr double ADAPTIVE_MAX_RATIO = 0.5;     // cursor-sized changes, noisy ones still see a full slide change
+    constexpr double MAD_TO_SIGMA = 1.4826;        // MAD of a normal distribution -> standard deviation
+
+    /**
+     * @brief Streaming estimate of one quantile (P-square algorithm, Jain & Chlamtac 1985).
+     * Five markers follow the minimum, the quantile, the maximum and two points in between;
+     * O(1) memory and time per sample, no samples are stored. Exact for the first five samples.
+     */
+    class StreamingQuantile
+    {
+    public:
+        explicit StreamingQuantile(double quantile = 0.5);
+
+        void add(double x);
+        double value() const; // 0.0 before the first sample
+        uint64_t count() const { return count_; }
+
+    private:
+        double quantile_;
+        uint64_t count_ = 0;
+        std::array<double, 5> heights_{};   // Marker values (the first samples until there are five)
+        std::array<double, 5> positions_{}; // Actual marker positions
+        std::array<double, 5> desired_{};   // Desired marker positions
+        std::array<double, 5> increments_{};
+    };
+
+    /**
+     * @brief Noise floor of the change scores of one video: running median and MAD (median absolute
+     * deviation from the running median), both streaming quantile estimates.
+     * Robust, so the rare slide transitions among the scores barely move it.
+     */
+    class NoiseFloor
+    {
+    public:
+        void add(double score);
+
+        uint64_t count() const { return median_.count(); }
+        double median() const { return median_.value(); }
+        double mad() const { return deviation_.value(); }
+
+        /**
+         * @brief median + sensitivity robust standard deviations, clamped to
+         * ADAPTIVE_MIN_RATIO - ADAPTIVE_MAX_RATIO.
+         */
+        double threshold(double sensitivity) const;
+
+    private:
+        StreamingQuantile median_{0.5};
+        StreamingQuantile deviation_{0.5};
+    };
+
+} // namespace ai_interview
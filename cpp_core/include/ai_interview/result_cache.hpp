@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ai_interview/slide_detector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ai_interview
+{
+    // Result cache configuration
+    constexpr uint32_t RESULT_CACHE_VERSION = 4;               // Bump when the file layout changes
+    constexpr size_t FINGERPRINT_BLOCK_SIZE = 64 * 1024;       // Bytes read per sampled block
+    constexpr int FINGERPRINT_BLOCKS = 16;                     // Blocks sampled evenly over the file
+
+    /**
+     * @brief Identifies one cached detection result.
+     */
+    struct ResultCacheKey
+    {
+        uint64_t content = 0; // fingerprint_video_file() / fingerprint_video_buffer()
+        uint64_t params = 0;  // Hash of every setting that can change the result
+    };
+
+    /**
+     * @brief Fast 64-bit hash (8 bytes per step, multiply + rotate mixing). Not cryptographic.
+     */
+    uint64_t hash_bytes(const void *data, size_t size, uint64_t seed = 0);
+
+    /**
+     * @brief Content fingerprint of a video file: hash of its size and FINGERPRINT_BLOCKS sampled
+     * blocks (the first and last block included), so only ~1 MB is read whatever the file size.
+     * @return false if the file can't be read.
+     */
+    bool fingerprint_video_file(const std::string &path, uint64_t &fingerprint);
+
+    /**
+     * @brief Same fingerprint for a video held in memory (equal to that of the same bytes in a file).
+     */
+    bool fingerprint_video_buffer(const uint8_t *data, size_t size, uint64_t &fingerprint);
+
+    /**
+     * @brief File name of a cache entry inside `directory` ("<content>-<params>.slides").
+     */
+    std::string result_cache_path(const std::string &directory, const ResultCacheKey &key);
+
+    /**
+     * @brief Read a cache entry. Segments and, if they were stored, frames / encoded images.
+     * @return false on a miss: no file, another version or key, or a truncated or corrupt file.
+     */
+    bool load_cached_result(const std::string &path, const ResultCacheKey &key, std::vector<CapturedSlide> &slides);
+
+    /**
+     * @brief Write a cache entry (temporary file + rename, so readers never see a partial file).
+     * @return false if it could not be written; the cache is an optimization, so callers ignore that.
+     */
+    bool store_cached_result(const std::string &path, const ResultCacheKey &key, const std::vector<CapturedSlide> &slides);
+
+} // namespace ai_interview
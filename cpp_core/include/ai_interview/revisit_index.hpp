@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ai_interview/change_metrics.hpp"
+#include <iterator>
+#include <list>
+
+namespace ai_interview
+{
+    struct SlideSegment;
+
+    /**
+     * @brief Least-recently-used set of the last distinct slides, to recognize when an earlier
+     * slide comes back (the speaker scrolls back, shows the agenda again, ...).
+     * Slides are compared by their edge occupancy maps (compute_occupancy_map, ~2 KB each)
+     * with occupancy_change_ratio.
+     */
+    class RevisitIndex
+    {
+    public:
+        /**
+         * @param capacity Number of distinct slides remembered (0 = off: every slide is new).
+         * @param max_change_ratio A slide is a revisit if it differs from a remembered one by at most this.
+         */
+        explicit RevisitIndex(int capacity = 0, double max_change_ratio = 0.0);
+
+        bool enabled() const { return capacity_ > 0; }
+
+        /**
+         * @brief Give the segment its slide_id: the id of the closest remembered slide if it is
+         * a revisit (is_revisit = true, that slide becomes the most recent one),
+         * otherwise a new id (the least recently seen slide may be forgotten).
+         * The previous slide (most recent entry) is never matched, and build-up segments
+         * (is_build_up) are never revisits.
+         */
+        void classify(SlideSegment &segment, PackedEdges occupancy);
+
+    private:
+        // New id for the segment, remembered as the most recent slide
+        void remember(SlideSegment &segment, PackedEdges occupancy);
+
+        struct Entry
+        {
+            int slide_id;
+            PackedEdges occupancy;
+        };
+
+        int capacity_;
+        double max_change_ratio_;
+        int next_id_ = 0;
+        std::list<Entry> entries_; // Most recently seen first
+    };
+
+} // namespace ai_interview
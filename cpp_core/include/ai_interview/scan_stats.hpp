@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace ai_interview
+{
+    // Stage timing histogram: bucket i counts durations below 2^i microseconds, the last one everything longer
+    constexpr int STAGE_HISTOGRAM_BUCKETS = 24;
+
+    /**
+     * @brief Timed stages of the per-frame hot path.
+     */
+    enum class ScanStage
+    {
+        Decode,       // cap.grab(): demux + decode (every frame, analyzed or not)
+        Convert,      // cap.retrieve(): conversion of the decoded frame to BGR / gray (analyzed frames only)
+        Thumbnail,    // Coarse stage thumbnail
+        Resize,       // Crop + resize to the analysis width
+        EdgeMap,      // compute_edge_map (gray, blur, Canny, dilate)
+        ChangeMetric, // Comparison with the reference (calculate_change_metric / packed tiles)
+        Count
+    };
+    constexpr int NUM_SCAN_STAGES = static_cast<int>(ScanStage::Count);
+
+    /**
+     * @brief Name of a stage ("decode", "convert", ...), e.g. for metric labels.
+     */
+    const char *scan_stage_name(ScanStage stage);
+
+    /**
+     * @brief Aggregated timings of one stage: count, total, max and a log2 histogram.
+     */
+    struct StageStats
+    {
+        uint64_t count = 0;
+        double total_sec = 0.0;
+        double max_sec = 0.0;
+        std::array<uint64_t, STAGE_HISTOGRAM_BUCKETS> histogram{};
+
+        void add(double seconds);
+        void merge(const StageStats &other);
+        double mean_sec() const { return count > 0 ? total_sec / count : 0.0; }
+
+        /**
+         * @brief Upper bound of histogram bucket i in seconds (the last bucket has no bound: infinity).
+         */
+        static double bucket_upper_bound_sec(int bucket);
+    };
+
+    /**
+     * @brief Counters and stage timings of one process_video / process_video_with_frames call.
+     * Collected per thread and merged at the end, so the hot path takes no locks.
+     * With the pipeline or chunks the stage times are summed over the threads (CPU time per stage),
+     * while wall_sec is the elapsed time of the call.
+     */
+    struct ScanStats
+    {
+        uint64_t frames_decoded = 0;  // Frames grabbed from the decoder
+        uint64_t frames_skipped = 0;  // Grabbed but not analyzed (sampling stride, min_scene_duration)
+        uint64_t frames_analyzed = 0; // Went through the analysis (includes re-scored frames of the pipeline / chunk merge)
+        uint64_t frames_static = 0;   // Stopped by the coarse stage before the edge map
+        uint64_t slides = 0;          // Segments returned
+        bool cache_hit = false;       // Result read from the result cache (no scan, all counters 0)
+        double wall_sec = 0.0;
+        uint64_t start_rss_bytes = 0; // Resident set size of the process when the call started (0 = unknown)
+        uint64_t peak_rss_bytes = 0;  // Largest one sampled during the call (every PROGRESS_CHECK_FRAMES frames)
+        std::array<StageStats, NUM_SCAN_STAGES> stages;
+
+        StageStats &stage(ScanStage s) { return stages[static_cast<int>(s)]; }
+        const StageStats &stage(ScanStage s) const { return stages[static_cast<int>(s)]; }
+
+        // Adds the frame counters and stage timings of `other` (slides, cache_hit, wall_sec and RSS are per call)
+        void merge(const ScanStats &other);
+    };
+
+    /**
+     * @brief Resident set size of this process in bytes (/proc/self/statm; 0 where it is not available).
+     * Process-wide: includes whatever else the process holds besides the scan.
+     */
+    uint64_t current_rss_bytes();
+
+    /**
+     * @brief Adds the time between construction and destruction to a stage (steady_clock, ~20 ns per read).
+     */
+    class ScopedStageTimer
+    {
+    public:
+        ScopedStageTimer(ScanStats &stats, ScanStage stage)
+            : stats_(stats.stage(stage)),
+              start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedStageTimer()
+        {
+            stats_.add(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+        }
+
+        ScopedStageTimer(const ScopedStageTimer &) = delete;
+        ScopedStageTimer &operator=(const ScopedStageTimer &) = delete;
+
+    private:
+        StageStats &stats_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+} // namespace ai_interview
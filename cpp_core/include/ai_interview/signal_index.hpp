@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ai_interview/slide_detector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ai_interview
+{
+    // Signal index configuration
+    constexpr uint32_t SIGNAL_INDEX_VERSION = 1;   // Bump when the file layout changes
+    constexpr int SIGNAL_BLOCK_SIZE = 8;           // Edge occupancy is recorded per 8x8 block (2x2 blocks per tile)
+    constexpr int SIGNAL_BLOCK_MIN_PIXELS = 4;     // A block is "occupied" if at least this many pixels are edges
+
+    /**
+     * @brief One analyzed (sampled) frame. Plain 32-byte record so the file can be memory-mapped
+     * (e.g. numpy.memmap with a structured dtype).
+     */
+    struct SignalRecord
+    {
+        int32_t frame_index;
+        int32_t reference_frame; // Frame index of the running reference when recorded (-1 = none yet)
+        double timestamp_sec;
+        double change_score;     // Exact score against that reference (0 if the coarse stage found it static)
+        uint64_t thumb_hash;     // 64-bit average hash of the 8x8 downscaled thumbnail
+    };
+
+    /**
+     * @brief Per-frame change signal of a video, recorded once by SlideDetector::build_signal_index.
+     *
+     * File layout (native byte order):
+     *   "AISI" | u32 version | f64 fps | f64 min_scene_duration | f64 min_area_ratio
+     *   | i32 block_rows | i32 block_cols | i32 words_per_row | u32 count
+     *   | count x SignalRecord | count x (block_rows * words_per_row) u64 occupancy words
+     */
+    struct SignalIndex
+    {
+        double fps = 0.0;
+        double min_scene_duration = 0.0; // Settings of the recording (fixed threshold: replaying them is exact)
+        double min_area_ratio = 0.0;
+        int block_rows = 0;              // Occupancy map size in SIGNAL_BLOCK_SIZE blocks
+        int block_cols = 0;
+        int words_per_row = 0;
+        std::vector<SignalRecord> records;
+        std::vector<uint64_t> occupancy; // Bit (x % 64) of word (x / 64) in a row = block x has edges
+
+        size_t signature_words() const { return static_cast<size_t>(block_rows) * words_per_row; }
+        const uint64_t *signature(size_t i) const { return occupancy.data() + i * signature_words(); }
+    };
+
+    /**
+     * @brief Edge occupancy map of a CV_8UC1 edge map: bit per SIGNAL_BLOCK_SIZE block, set if it
+     * holds at least SIGNAL_BLOCK_MIN_PIXELS edge pixels. ~2 KB for 1280x720.
+     * @param blocks Scratch buffer (block-resolution image), reused between calls.
+     */
+    void compute_occupancy_map(const cv::Mat &edges, cv::Mat &blocks, PackedEdges &occupancy);
+
+    /**
+     * @brief Estimated change between two occupancy maps of the same size: fraction of tiles
+     * (2x2 blocks) where any block gained or lost edges. Approximates ChangeMetric::Tiles.
+     */
+    double occupancy_change_ratio(const uint64_t *a, const uint64_t *b, int block_rows, int block_cols,
+                                  int words_per_row);
+    double occupancy_change_ratio(const PackedEdges &a, const PackedEdges &b);
+
+    /**
+     * @brief Save an index (see the SignalIndex layout).
+     * @throws std::runtime_error If the file can't be written.
+     */
+    void save_signal_index(const std::string &path, const SignalIndex &index);
+
+    /**
+     * @brief Load an index saved by save_signal_index.
+     * @throws std::runtime_error If the file is missing, truncated or of another version.
+     */
+    SignalIndex load_signal_index(const std::string &path);
+
+    /**
+     * @brief occupancy_change_ratio between records a and b of the index.
+     */
+    double estimate_change_ratio(const SignalIndex &index, size_t a, size_t b);
+
+    /**
+     * @brief Re-run the slide selection for other thresholds without decoding anything.
+     * Same fixed-threshold rule as process_video (first frame, min_scene_duration, min_area_ratio).
+     * Where the replayed reference is the recorded one the exact score is used, otherwise
+     * estimate_change_ratio. So for a fixed-threshold scan the recording's own settings select the
+     * same frame_index / timestamp_sec as process_video. Not replayed: the adaptive threshold
+     * (set_adaptive_threshold), revisits (slide_id is the slide number, is_revisit is false),
+     * changed_regions and is_build_up.
+     */
+    std::vector<SlideSegment> select_segments(const SignalIndex &index, double min_scene_duration,
+                                              double min_area_ratio);
+
+} // namespace ai_interview
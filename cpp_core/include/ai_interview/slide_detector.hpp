@@ -1,6 +1,17 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include "ai_interview/change_metrics.hpp"
+#include "ai_interview/noise_floor.hpp"
+#include "ai_interview/revisit_index.hpp"
+#include "ai_interview/scan_stats.hpp"
+#include "ai_interview/video_source.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -14,10 +25,52 @@ namespace ai_interview
     constexpr int CANNY_THRESHOLD_LOW = 50;
     constexpr int CANNY_THRESHOLD_HIGH = 150;
     constexpr int DILATION_KERNEL_SIZE = 3;
+    // In get_frames: if the next requested frame is further ahead than this,
+    // seek instead of grabbing frame by frame (decoding a GOP is cheaper than hundreds of frames)
+    constexpr int BATCH_SEEK_GAP_FRAMES = 300;
+    // Coarse stage: tiny grayscale thumbnail compared before the expensive edge path
+    constexpr int COARSE_THUMB_WIDTH = 64;
+    constexpr int COARSE_THUMB_HEIGHT = 36;
+    // Threads used by process_video: 0 = all hardware threads, 1 = serial (no pipeline)
+    constexpr int DEFAULT_NUM_THREADS = 0;
+    // Chunked mode: don't split the video into time ranges shorter than this
+    constexpr double MIN_CHUNK_DURATION_SEC = 60.0;
+    // Overlay auto-detection (set_auto_exclude_duration): motion of a 64x36 gray grid sampled at 4 fps
+    constexpr int AUTO_REGION_GRID_WIDTH = 64;
+    constexpr int AUTO_REGION_GRID_HEIGHT = 36;
+    constexpr double AUTO_REGION_SAMPLE_FPS = 4.0;
+    constexpr int AUTO_REGION_MOTION_LEVEL = 6;    // Gray-level change of a cell that counts as motion
+    constexpr double AUTO_REGION_MIN_SHARE = 0.4;  // Cell moving in at least this share of the sampled frame pairs
+    constexpr int AUTO_REGION_MIN_CELLS = 4;       // Smaller moving blobs are noise (cursor, compression)
+    constexpr double AUTO_REGION_MAX_AREA = 0.25;  // Larger moving areas are content (a video), not an overlay
+    // ScanObserver: wall time between two progress reports, and how often (in decoded frames) the clock is read
+    constexpr double DEFAULT_PROGRESS_INTERVAL_SEC = 0.5;
+    constexpr int PROGRESS_CHECK_FRAMES = 16;
+    // Text regions (extract_text_regions), sizes in pixels of the analysis scale (DEFAULT_RESIZE_WIDTH)
+    constexpr double SLIDE_OUTLINE_MIN_AREA = 0.25;  // A quadrilateral outline must cover this share of the analyzed area
+    constexpr double SLIDE_OUTLINE_APPROX = 0.02;    // Polygon approximation tolerance (share of the contour perimeter)
+    constexpr double SLIDE_OUTLINE_MAX_OUTSIDE = 0.1; // Share of the edge pixels allowed outside it (else it is a box on the slide)
+    constexpr int TEXT_JOIN_KERNEL_WIDTH = 21;       // Closing that joins letters into lines...
+    constexpr int TEXT_JOIN_KERNEL_HEIGHT = 7;       // ...and lines into blocks
+    constexpr int TEXT_MIN_BLOCK_HEIGHT = 8;         // Lower blocks are rules, underlines, noise
+    constexpr double TEXT_MIN_EDGE_DENSITY = 0.15;   // Edge pixels per block pixel; sparse blocks are lines / borders
+    constexpr int DEFAULT_TEXT_REGION_PADDING = 8;   // Added around every region (full-resolution pixels)
+    // Changed regions of a new slide (SlideSegment::changed_regions), sizes at the analysis scale
+    constexpr int CHANGE_REGION_JOIN_SIZE = 15;      // Changes closer than this (pixels) form one region
+    constexpr double CHANGE_REGION_MIN_AREA = 0.001; // Smaller regions (share of the analyzed area) are noise
+    constexpr double BUILD_UP_MAX_REMOVED = 0.1;     // A build-up keeps all but this share of the previous slide's edges
+    // Slide previews (make_thumbnails)
+    constexpr int DEFAULT_THUMBNAIL_WIDTH = 320;
+    constexpr int DEFAULT_THUMBNAIL_QUALITY = 80;    // JPEG / WebP quality (1 - 100)
+    constexpr int DEFAULT_SPRITE_COLUMNS = 5;
+    // Memory budget (set_memory_budget): share of the budget for decoded frames in flight
+    // (pipeline ring, chunk decoders); the rest is for the captured keyframes
+    constexpr double PIPELINE_MEMORY_SHARE = 0.5;
+    constexpr int MIN_PIPELINE_SLOTS = 2; // One being decoded, one being analyzed
 
     /**
      * @brief Structure describing a detected slide.
-     * We use a POD (Plain Old Data) structure so that pybind11
+     * We use a plain aggregate so that pybind11
      * can easily convert it to a Python dict or object.
      */
     struct SlideSegment
@@ -25,10 +78,216 @@ namespace ai_interview
         int frame_index;      // Frame number where the slide appeared
         double timestamp_sec; // Timestamp in seconds
         double change_ratio;  // Screen change percentage (0.0 - 1.0) compared to previous slide
+        int slide_id = -1;       // Distinct slide number; a revisited slide keeps the id of its first appearance
+        bool is_revisit = false; // An earlier slide shown again (see SlideDetector::set_revisit_history)
+
+        // What changed since the previous slide: merged rectangles in fractions of the frame
+        // (like AnalysisRegion), in reading order. Empty for the first slide and for select_segments.
+        std::vector<cv::Rect2d> changed_regions = {};
+        // The previous slide is still there with content added (bullet reveal, build-up animation):
+        // only changed_regions is new
+        bool is_build_up = false;
+    };
+
+    /**
+     * @brief Engine used to score the change between the reference slide and a frame.
+     */
+    enum class ChangeMetric
+    {
+        Contours,   // absdiff + findContours, sum of bounding-rect areas (original algorithm, default)
+        Tiles,      // Fused one-pass XOR + per-tile popcount, fraction of dirty tiles (much cheaper)
+        PackedTiles // Same score as Tiles on 1-bit packed edge maps; references are stored packed (8x smaller)
+    };
+
+    /**
+     * @brief Where the per-frame analysis runs.
+     */
+    enum class ComputeBackend
+    {
+        CPU,   // Plain cv::Mat (default)
+        OpenCL // OpenCV T-API (cv::UMat): frames are uploaded once and stay on the GPU until the
+               // change score; only scalars come back. Falls back to CPU kernels if no OpenCL device.
+    };
+
+    /**
+     * @brief Hardware video decoding requested from cv::VideoCapture (CAP_PROP_HW_ACCELERATION).
+     * Values match cv::VideoAccelerationType. CUDA/NVDEC is not a separate type in OpenCV's
+     * FFmpeg backend: Any lets it pick whatever the build and the machine support.
+     */
+    enum class DecodeAcceleration
+    {
+        None = cv::VIDEO_ACCELERATION_NONE, // Software decode (default)
+        Any = cv::VIDEO_ACCELERATION_ANY,
+        D3D11 = cv::VIDEO_ACCELERATION_D3D11,
+        VAAPI = cv::VIDEO_ACCELERATION_VAAPI,
+        MFX = cv::VIDEO_ACCELERATION_MFX
+    };
+
+    /**
+     * @brief How a video was actually opened (see SlideDetector::get_decode_info).
+     */
+    struct DecodeInfo
+    {
+        std::string backend;                                          // VideoCapture backend, e.g. "FFMPEG"
+        DecodeAcceleration acceleration = DecodeAcceleration::None;   // None if decoding in software
+        int device = -1;                                              // Hardware device index (-1 = default / none)
+        bool fallback = false;                                        // Opening with acceleration failed, reopened in software
+    };
+
+    /**
+     * @brief Options of SlideDetector::extract_text_regions.
+     */
+    struct TextRegionOptions
+    {
+        bool deskew = true;    // Rectify a slide seen at an angle (camera filming a projector or a screen)
+        bool binarize = false; // Otsu, dark text on white, 8-bit gray regions instead of BGR crops
+        int padding = DEFAULT_TEXT_REGION_PADDING;
+    };
+
+    /**
+     * @brief Dense text block of a slide.
+     */
+    struct TextRegion
+    {
+        cv::Rect rect;              // In pixels of the slide crop (SlideCrop::slide)
+        cv::Mat image;              // BGR crop, or gray if binarized (raw mode)
+        std::vector<uchar> encoded; // Encoded crop (FrameCaptureOptions::encoding)
+    };
+
+    /**
+     * @brief Slide found in a frame, with its text blocks in reading order (top to bottom, left to right).
+     */
+    struct SlideCrop
+    {
+        std::vector<cv::Point2f> corners; // Slide outline in frame pixels: top-left, top-right, bottom-right, bottom-left
+        bool deskewed = false;            // The outline was a quadrilateral and the slide was rectified
+        cv::Mat slide;                    // The slide alone, full resolution
+        std::vector<TextRegion> regions;
+    };
+
+    /**
+     * @brief How process_video_with_frames should keep the slide images.
+     */
+    struct FrameCaptureOptions
+    {
+        int max_width = 0;         // Downscale captured frames wider than this (0 = keep full resolution)
+        std::string encoding;      // "" = raw BGR Mat, ".jpg" / ".png" = encoded bytes (cv::imencode extension)
+        int jpeg_quality = 95;     // Only used for ".jpg"
+        bool text_regions = false; // Also extract the text regions of every slide (full resolution, not downscaled)
+        TextRegionOptions text;    // Options of that extraction
+    };
+
+    /**
+     * @brief Options of SlideDetector::make_thumbnails.
+     */
+    struct ThumbnailOptions
+    {
+        int width = DEFAULT_THUMBNAIL_WIDTH;   // Thumbnail width; height keeps the aspect ratio (never upscaled)
+        std::string encoding = ".jpg";         // ".jpg", ".webp" or ".png" (cv::imencode extension)
+        int quality = DEFAULT_THUMBNAIL_QUALITY;
+        bool sprite_sheet = false;             // Also tile all thumbnails into one image
+        int sprite_columns = DEFAULT_SPRITE_COLUMNS;
+        std::string output_dir;                // "" = return the bytes; otherwise write files and return their paths
+    };
+
+    /**
+     * @brief Encoded preview of one frame. Exactly one of encoded / path is filled
+     * (neither if the frame doesn't exist).
+     */
+    struct Thumbnail
+    {
+        int frame_index = -1;
+        std::vector<uchar> encoded;
+        std::string path; // <output_dir>/slide_<frame_index><encoding>
+    };
+
+    /**
+     * @brief Result of SlideDetector::make_thumbnails.
+     */
+    struct ThumbnailSet
+    {
+        std::vector<Thumbnail> thumbnails; // Same order as the requested frame indices
+        // ThumbnailOptions::sprite_sheet: thumbnail i is the tile at row i / columns, column i % columns
+        std::vector<uchar> sprite;
+        std::string sprite_path; // <output_dir>/sprite<encoding>
+        int sprite_columns = 0;
+        cv::Size tile_size;
+    };
+
+    /**
+     * @brief Slide metadata together with the image of its first frame.
+     * Exactly one of frame / encoded / spill_path is filled, depending on FrameCaptureOptions::encoding
+     * and on the memory budget.
+     */
+    struct CapturedSlide
+    {
+        SlideSegment segment;
+        cv::Mat frame;              // BGR image (raw mode)
+        std::vector<uchar> encoded; // Encoded image (encoding mode)
+        std::vector<TextRegion> text_regions; // FrameCaptureOptions::text_regions: raw or encoded like the frame
+        std::string spill_path;     // Image file written over the memory budget (the caller deletes it)
     };
 
+    /**
+     * @brief Part of the frame that is analyzed. Rectangles are in fractions of the frame size
+     * (x, y, width, height in 0.0 - 1.0), so they apply at any resolution.
+     */
+    struct AnalysisRegion
+    {
+        cv::Rect2d include = cv::Rect2d(0.0, 0.0, 1.0, 1.0); // Slide area: the rest of the frame is not analyzed
+        std::vector<cv::Rect2d> exclude;                     // Ignored parts (webcam overlay, clock, ...)
+
+        bool is_full_frame() const { return exclude.empty() && include == cv::Rect2d(0.0, 0.0, 1.0, 1.0); }
+    };
+
+    /**
+     * @brief How far a scan has got (see ScanObserver).
+     */
+    struct ScanProgress
+    {
+        int frames_processed = 0; // Frames decoded so far (all chunks together)
+        int total_frames = 0;     // CAP_PROP_FRAME_COUNT: an estimate, 0 if the container doesn't store it
+        bool done = false;        // Last report of the scan
+
+        double fraction() const
+        {
+            if (done)
+                return 1.0;
+            return total_frames > 0 ? std::min(1.0, static_cast<double>(frames_processed) / total_frames) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Early results of process_video / process_video_with_frames, delivered while the scan runs.
+     * The callbacks run on the scanning threads, one at a time; keep them short (hand the work to a
+     * queue). An exception thrown by a callback aborts the scan and is rethrown by process_video*.
+     * Slides arrive in order, each one as soon as it is final: immediately in serial and pipelined
+     * scans, after the merge in chunked scans and with reduced_decode frame capture.
+     * A cached result is reported at once, followed by the final progress.
+     */
+    struct ScanObserver
+    {
+        std::function<void(const SlideSegment &)> on_segment;  // Every detected slide
+        std::function<void(const CapturedSlide &)> on_slide;   // process_video_with_frames: the slide with its image
+        std::function<void(const ScanProgress &)> on_progress; // Every progress_interval_sec and once at the end
+        double progress_interval_sec = DEFAULT_PROGRESS_INTERVAL_SEC;
+    };
+
+    struct ResultCacheKey; // result_cache.hpp
+    struct SignalIndex;    // signal_index.hpp
+
+    /**
+     * @brief Slide transition detector.
+     * Thread safety: all processing methods are const and keep their state in locals,
+     * so one instance can be used from several threads at once.
+     * The set_* configuration methods must not be called while a scan is running.
+     * The streaming API (begin/push_frame/finish) is the exception: it keeps one stream
+     * per instance, so use a separate detector for every concurrent stream.
+     */
     class SlideDetector
     {
+        struct Workspace; // Per-thread scratch buffers (defined below)
+
     public:
         /**
          * @brief Constructor
@@ -48,31 +307,652 @@ namespace ai_interview
         /**
          * @brief Main video processing pipeline.
          * Reads video, searches for transitions, returns list of unique moments.
-         * @param video_path Path to mp4 file.
+         * @param video Path to mp4 file, or a memory / stream VideoSource.
+         * @param stats If set, receives the frame counters and per-stage timings of this call.
          * @return std::vector<SlideSegment> List of metadata about slides.
          */
-        std::vector<SlideSegment> process_video(const std::string &video_path);
+        std::vector<SlideSegment> process_video(const VideoSource &video, ScanStats *stats = nullptr) const;
+
+        /**
+         * @brief process_video that reports every slide and the progress while scanning (see ScanObserver),
+         * e.g. to start OCR on the first slides before the scan is done.
+         */
+        std::vector<SlideSegment> process_video(const VideoSource &video, const ScanObserver &observer,
+                                                ScanStats *stats = nullptr) const;
+
+        /**
+         * @brief Same as process_video, but also keeps the image of every detected slide.
+         * The frames are captured while scanning, so Python doesn't need a second
+         * decode pass through get_frame/get_frames.
+         * Memory: one (optionally downscaled/encoded) frame per slide, not per video frame.
+         */
+        std::vector<CapturedSlide> process_video_with_frames(const VideoSource &video,
+                                                             const FrameCaptureOptions &options = FrameCaptureOptions(),
+                                                             ScanStats *stats = nullptr) const;
+
+        /**
+         * @brief process_video_with_frames with early results (ScanObserver::on_slide gets the images).
+         */
+        std::vector<CapturedSlide> process_video_with_frames(const VideoSource &video,
+                                                             const FrameCaptureOptions &options,
+                                                             const ScanObserver &observer,
+                                                             ScanStats *stats = nullptr) const;
+
+        /**
+         * @brief Record the change signal of every sampled frame (score against the running
+         * reference, thumbnail hash, 8x8-block edge occupancy) in one decode pass.
+         * Save it with save_signal_index; select_segments then re-runs the slide selection for
+         * any min_scene_duration / min_area_ratio without decoding (see signal_index.hpp).
+         * Sampling, metric and backends are the current settings.
+         */
+        SignalIndex build_signal_index(const VideoSource &video) const;
 
         /**
          * @brief Helper for Python: extract a specific frame as an image.
          * We don't store all images in memory (that would kill RAM).
          * Python gets indices from process_video, then requests needed frames via this method.
          */
-        cv::Mat get_frame(const std::string &video_path, int frame_index);
+        cv::Mat get_frame(const VideoSource &video, int frame_index) const;
+
+        /**
+         * @brief Batch version of get_frame: extract many frames in a single pass.
+         * Opens the video once, sorts the requested indices and walks forward with
+         * grab()/retrieve(), so only the requested frames are actually decoded to BGR.
+         * @param video Path to mp4 file, or a memory / stream VideoSource.
+         * @param frame_indices Frame numbers to extract (any order, duplicates allowed).
+         * @return Frames in the same order as frame_indices. Missing frames are empty Mats.
+         */
+        std::vector<cv::Mat> get_frames(const VideoSource &video, std::vector<int> frame_indices) const;
+
+        /**
+         * @brief Small encoded previews of many frames (e.g. every segment), optionally tiled into a
+         * sprite sheet as well. One get_frames-style decode pass; every frame is downscaled and
+         * encoded on a worker pool (num_threads) while the next ones are decoded, and released as
+         * soon as its thumbnail exists: nothing full-resolution is returned or kept.
+         * @throws std::invalid_argument If an option is out of range.
+         * @throws std::runtime_error If the video can't be opened, or an image can't be encoded / written.
+         */
+        ThumbnailSet make_thumbnails(const VideoSource &video, const std::vector<int> &frame_indices,
+                                     const ThumbnailOptions &options = ThumbnailOptions()) const;
+
+        /**
+         * @brief Cut the slide out of a frame and find its dense text blocks, so OCR only sees text.
+         * Works on the detection edge map (analysis scale, exclude regions blanked): the slide outline is
+         * its largest convex quadrilateral with nearly all edges inside, else the bounding box of the
+         * edges (drops margins, letterboxing, a blanked webcam). Blocks are edges joined by a closing.
+         * @param region Analyzed part of the frame (the other overload uses the configured region).
+         * @return SlideCrop whose regions are empty if no text block was found (OCR the slide then).
+         */
+        SlideCrop extract_text_regions(const cv::Mat &frame, const TextRegionOptions &options = TextRegionOptions()) const;
+        SlideCrop extract_text_regions(const cv::Mat &frame, const TextRegionOptions &options,
+                                       const AnalysisRegion &region) const;
+
+        // --- Temporal sampling ---
+        // Slides change on a scale of seconds, so analyzing all 30-60 fps is wasted work.
+        // Skipped frames are only grab()-ed (no retrieve / color conversion),
+        // so frame_index and timestamp_sec of the segments stay exact.
+
+        /**
+         * @brief Analyze only every N-th frame (1 = every frame, the default).
+         * Ignored when a target analysis FPS is set.
+         */
+        void set_frame_stride(int stride);
+        int get_frame_stride() const { return frame_stride_; }
+
+        /**
+         * @brief Analyze approximately this many frames per second of video
+         * (the stride is derived from the video FPS). 0 disables it (use frame stride).
+         */
+        void set_target_analysis_fps(double fps);
+        double get_target_analysis_fps() const { return target_analysis_fps_; }
+
+        // --- Coarse-to-fine detection ---
+        // Most frames are static. Before running Canny, a 64x36 grayscale thumbnail is compared
+        // with the reference slide's thumbnail (mean absolute difference, 0-255 gray levels).
+        // If it is below the threshold the frame is treated as "no change" and skips the edge path.
+
+        /**
+         * @brief Mean-abs-diff threshold of the thumbnail stage. 0 disables the stage (default).
+         */
+        void set_coarse_threshold(double threshold);
+        double get_coarse_threshold() const { return coarse_threshold_; }
+
+        // --- Multithreading ---
+        // With more than one thread process_video runs as a pipeline:
+        // one decoder thread -> ring buffer of frames -> N edge-map workers -> in-order decision stage.
+        // The result is identical to the serial loop.
+
+        /**
+         * @brief Number of threads for process_video (0 = hardware concurrency, 1 = serial).
+         */
+        void set_num_threads(int num_threads);
+        int get_num_threads() const { return num_threads_; }
+
+        /**
+         * @brief Split long videos into K time ranges, each scanned by its own VideoCapture in parallel
+         * (0 or 1 = off, the default). Ranges shorter than MIN_CHUNK_DURATION_SEC are not created.
+         * Every chunk boundary is re-checked against the previous chunk's final reference,
+         * so the segments are identical to a single pass.
+         * Requires a seekable file with a known frame count; otherwise falls back to one pass.
+         */
+        void set_num_chunks(int num_chunks);
+        int get_num_chunks() const { return num_chunks_; }
+
+        /**
+         * @brief Select the change metric engine (see ChangeMetric). Both return a 0.0 - 1.0
+         * ratio compared against min_area_ratio. Tiles doesn't double-count overlapping changes,
+         * so validate the threshold on real recordings (scripts/compare_metrics.py) when switching.
+         */
+        void set_change_metric(ChangeMetric metric) { change_metric_ = metric; }
+        ChangeMetric get_change_metric() const { return change_metric_; }
+
+        /**
+         * @brief Select the compute backend (see ComputeBackend).
+         * OpenCL supports all change metrics: Tiles/PackedTiles are computed on the device
+         * (tile means via INTER_AREA + countNonZero; exact when the analyzed size is a multiple
+         * of 16 like 1280x720), Contours downloads the diff image for findContours.
+         */
+        void set_compute_backend(ComputeBackend backend) { compute_backend_ = backend; }
+        ComputeBackend get_compute_backend() const { return compute_backend_; }
+
+        /**
+         * @brief True if OpenCV found an OpenCL device, i.e. ComputeBackend::OpenCL really uses the GPU.
+         */
+        static bool is_opencl_available();
+
+        /**
+         * @brief Name of the specialized per-frame analysis the current settings select, e.g.
+         * "packed_tiles/coarse/whole_area" or "opencl" (see slide_detector_kernels.cpp).
+         * For the configured region; auto-detected overlays make a scan use the "excluded_area" variant.
+         */
+        std::string get_analysis_kernel() const;
+
+        /**
+         * @brief Request hardware decoding for every VideoCapture the detector opens
+         * (scans, chunks, get_frame/get_frames).
+         * If the video can't be opened that way, it is reopened with software decoding.
+         * @param acceleration DecodeAcceleration::None (default) = software decode.
+         * @param device Hardware device index (-1 = default device).
+         */
+        void set_decode_acceleration(DecodeAcceleration acceleration, int device = -1);
+        DecodeAcceleration get_decode_acceleration() const { return decode_acceleration_; }
+        int get_decode_device() const { return decode_device_; }
+
+        /**
+         * @brief Open the video with the current decode settings and report what was used.
+         * @throws std::runtime_error If the video can't be opened at all.
+         */
+        DecodeInfo get_decode_info(const VideoSource &video) const;
+
+        /**
+         * @brief Let the decoder produce the analysis frames directly: grayscale (luma plane only)
+         * at DEFAULT_RESIZE_WIDTH, via a GStreamer capture pipeline (videoconvert to GRAY8 +
+         * videoscale). Skips the full-resolution BGR conversion, the cv::resize and the cvtColor.
+         * Full-resolution frames are then decoded only for the emitted slides
+         * (process_video_with_frames does a get_frames pass).
+         * Falls back to the normal decode when OpenCV has no GStreamer backend or the pipeline
+         * fails. Chunked scans keep the normal decode (GStreamer seeking is not frame-accurate).
+         * The scaler differs from cv::resize, so scores can differ slightly from the default mode.
+         */
+        void set_reduced_decode(bool enabled) { reduced_decode_ = enabled; }
+        bool get_reduced_decode() const { return reduced_decode_; }
+
+        /**
+         * @brief Remember the last N distinct slides and tag a slide that comes back as a revisit
+         * (SlideSegment::is_revisit, with the slide_id of its first appearance) instead of a new slide.
+         * The segment is still emitted, so the timeline stays complete; downstream can skip OCR for it.
+         * Slides are compared by edge occupancy (see RevisitIndex) against min_area_ratio.
+         * 0 = off (the default): every segment gets a new slide_id.
+         */
+        void set_revisit_history(int num_slides);
+        int get_revisit_history() const { return revisit_history_; }
+
+        /**
+         * @brief Trigger on change relative to the video's own noise floor instead of a fixed min_area_ratio.
+         * The running median and MAD of the change scores (NoiseFloor: O(1) memory, same pass) give the
+         * threshold median + sensitivity * 1.4826 * MAD, clamped to ADAPTIVE_MIN_RATIO - ADAPTIVE_MAX_RATIO:
+         * heavily compressed recordings get a higher one, clean ones a lower one. min_area_ratio is used
+         * for the first ADAPTIVE_WARMUP_FRAMES scored frames and still drives revisit detection.
+         * Frames stopped by the coarse stage or by min_scene_duration are not scored.
+         * 0 = off (the default). The decisions depend on the whole past, so videos are not split
+         * into chunks in this mode (set_num_chunks is ignored; the pipeline still runs).
+         * @throws std::invalid_argument If sensitivity < 0.
+         */
+        void set_adaptive_threshold(double sensitivity);
+        double get_adaptive_threshold() const { return adaptive_sensitivity_; }
+
+        /**
+         * @brief Cache process_video / process_video_with_frames results on disk ("" = off, the default).
+         * Key: content fingerprint of the file (size + sampled blocks, see result_cache.hpp) plus every
+         * setting that can change the result (thresholds, analysis constants, sampling, metric, backend,
+         * capture options). A hit reads one small file instead of scanning the video.
+         * Threads/chunks don't change the result and are not part of the key.
+         */
+        void set_cache_dir(const std::string &directory) { cache_dir_ = directory; }
+        const std::string &get_cache_dir() const { return cache_dir_; }
+
+        /**
+         * @brief Bound the memory of one scan (bytes, 0 = unlimited, the default).
+         * PIPELINE_MEMORY_SHARE of it limits the decoded frames in flight: fewer pipeline slots
+         * (at least MIN_PIPELINE_SLOTS) and fewer chunks. With process_video_with_frames the rest is
+         * for the captured keyframes; once they exceed it, further slides are written to the spill
+         * directory (encoded with FrameCaptureOptions::encoding, PNG for raw mode) and returned with
+         * spill_path instead of pixels. Results with spilled slides are not stored in the result cache.
+         * Text regions stay in memory. ScanStats::peak_rss_bytes shows what the scan really used.
+         */
+        void set_memory_budget(size_t bytes) { memory_budget_ = bytes; }
+        size_t get_memory_budget() const { return memory_budget_; }
+
+        /**
+         * @brief Directory for slides spilled over the memory budget ("" = the system temp directory).
+         */
+        void set_spill_dir(const std::string &directory) { spill_dir_ = directory; }
+        const std::string &get_spill_dir() const { return spill_dir_; }
+
+        // --- Region of interest ---
+        // Only the include rectangle is decoded to edges (the frame is cropped before the resize),
+        // and exclude rectangles are blanked in the thumbnail and the edge map, so a picture-in-picture
+        // webcam neither costs edge detection nor counts as change. Change scores are relative to the
+        // analyzed (included, not excluded) area, so min_area_ratio keeps its meaning.
+
+        /**
+         * @brief Analyze only this part of the frame (fractions of the frame size; default = whole frame).
+         * @throws std::invalid_argument If the rectangle is empty or not inside 0.0 - 1.0.
+         */
+        void set_include_region(const cv::Rect2d &region);
+
+        /**
+         * @brief Ignore this part of the frame (fractions of the frame size).
+         * @throws std::invalid_argument If the rectangle is empty or not inside 0.0 - 1.0.
+         */
+        void add_exclude_region(const cv::Rect2d &region);
+        void clear_exclude_regions() { region_.exclude.clear(); }
+        const AnalysisRegion &get_analysis_region() const { return region_; }
+
+        /**
+         * @brief Look for a persistent high-motion area (a webcam overlay) in the first N seconds of every
+         * video file and exclude it for that scan. 0 = off (the default). Not used by the streaming API.
+         * A moving area is excluded if it covers at most AUTO_REGION_MAX_AREA of the frame.
+         */
+        void set_auto_exclude_duration(double seconds);
+        double get_auto_exclude_duration() const { return auto_exclude_sec_; }
+
+        /**
+         * @brief Region a scan of this video analyzes: the configured one plus the overlays found by
+         * the auto-detection (reads the first auto_exclude_duration seconds).
+         */
+        AnalysisRegion detect_analysis_region(const VideoSource &video) const;
+
+        // --- Single stages (benchmarks, native tests) ---
+        // The code the scan runs per frame, on caller-owned scratch buffers, so repeated calls
+        // measure the steady state (no allocations after the first call). The include / exclude
+        // regions apply; stage timings are not recorded.
+
+        /**
+         * @brief Scratch buffers for the single-stage calls (one per thread).
+         */
+        class StageBuffers
+        {
+        public:
+            StageBuffers();
+            ~StageBuffers();
+            StageBuffers(StageBuffers &&) noexcept;
+            StageBuffers &operator=(StageBuffers &&) noexcept;
+
+        private:
+            friend class SlideDetector;
+            std::unique_ptr<Workspace> ws_;
+        };
+
+        /**
+         * @brief Crop to the include region and resize to the analysis width (DEFAULT_RESIZE_WIDTH).
+         * Returns a view of `frame` if no resize is needed; otherwise the result lives in `buffers`.
+         */
+        cv::Mat resize_frame(const cv::Mat &frame, StageBuffers &buffers) const;
+
+        /**
+         * @brief Edge map (gray, blur, Canny, dilate, exclude mask) of a frame already at the analysis size.
+         */
+        void edge_map(const cv::Mat &analysis_frame, cv::Mat &edges, StageBuffers &buffers) const;
+
+        /**
+         * @brief Change ratio between two edge maps with the current metric, relative to the analyzed area.
+         * PackedTiles packs both maps on every call; in a scan the reference is packed once, so measure
+         * pack_edges / packed_tile_change_ratio separately for that metric.
+         */
+        double change_ratio(const cv::Mat &edges1, const cv::Mat &edges2, StageBuffers &buffers) const;
+
+        // --- Streaming (incremental) detection ---
+        // For recordings that are still being uploaded/captured: frames are pushed one by one and
+        // every new slide is reported as soon as it is confirmed (the decision is final immediately).
+        // Sampling (stride / target FPS), the coarse stage and min_scene_duration apply as in process_video.
+
+        /**
+         * @brief Start a new stream (discards the state of a previous unfinished one).
+         */
+        void begin();
+
+        /**
+         * @brief Feed the next frame of the stream.
+         * @param frame BGR or grayscale frame (any resolution, it's resized like in process_video).
+         * @param timestamp_sec Presentation time of the frame, must not decrease.
+         * @return Newly confirmed slides (empty or one segment). frame_index is the
+         * number of frames pushed before this one.
+         */
+        std::vector<SlideSegment> push_frame(const cv::Mat &frame, double timestamp_sec);
+
+        /**
+         * @brief End the stream.
+         * @return All segments detected during the stream (same as the union of push_frame results).
+         */
+        std::vector<SlideSegment> finish();
 
     private:
         double min_duration_;
         double min_area_ratio_;
-        int frame_width_;
-        int frame_height_;
+        int frame_stride_;
+        double target_analysis_fps_;
+        double coarse_threshold_;
+        int num_threads_;
+        int num_chunks_;
+        ChangeMetric change_metric_;
+        ComputeBackend compute_backend_;
+        DecodeAcceleration decode_acceleration_;
+        int decode_device_;
+        bool reduced_decode_;
+        std::string cache_dir_;
+        size_t memory_budget_;
+        std::string spill_dir_;
+        int revisit_history_;
+        double adaptive_sensitivity_;
+        AnalysisRegion region_;
+        double auto_exclude_sec_;
+        cv::Mat dilation_kernel_; // Built once, read-only afterwards
+        cv::Mat join_kernel_;     // describe_change: joins changes closer than CHANGE_REGION_JOIN_SIZE
 
         // Internal methods for logic (hidden from Python)
 
-        // 1. Converts frame to B&W contours (Canny Edge Detection)
-        cv::Mat compute_edge_map(const cv::Mat &frame);
+        // Open a capture with the decode settings, falling back to software decoding
+        // @throws std::runtime_error If the video can't be opened
+        DecodeInfo open_capture(cv::VideoCapture &cap, const VideoSource &video) const;
+
+        // Reopen `cap` (already opened by open_capture) as a gray, analysis-size GStreamer pipeline.
+        // Returns false and leaves a normal capture in `cap` if that's not possible.
+        bool open_reduced_capture(cv::VideoCapture &cap, const VideoSource &video) const;
+
+        // Result cache key for this video and the current settings (`extra` = capture options hash).
+        // Returns false if caching is off or the video can't be fingerprinted (callback streams).
+        bool cache_key(const VideoSource &video, uint64_t extra, ResultCacheKey &key) const;
+
+        // Called for every emitted segment with the full-resolution decoded frame
+        using SlideCallback = std::function<void(const SlideSegment &, const cv::Mat &)>;
+
+        // Progress and early results of one process_video* call (slide_detector_progress.cpp).
+        // Decoder threads count frames lock-free; the observer callbacks are serialized.
+        class ScanReporter
+        {
+        public:
+            explicit ScanReporter(const ScanObserver &observer);
+
+            void set_total_frames(int total_frames) { total_frames_ = total_frames; }
+
+            // Hot path: one relaxed increment, the clock and RSS are read every PROGRESS_CHECK_FRAMES frames
+            void frame_decoded();
+
+            // Samples the resident set size into peak_rss (also done on construction)
+            void sample_memory();
+            uint64_t peak_rss() const { return peak_rss_.load(std::memory_order_relaxed); }
+
+            void segment(const SlideSegment &segment);
+            void slide(const CapturedSlide &slide); // on_segment + on_slide
+            void finish();                          // Final progress (done = true)
+
+            // Whether the scan has to report segments at all (saves the SlideCallback otherwise)
+            bool wants_segments() const { return observer_.on_segment || observer_.on_slide; }
+
+        private:
+            const ScanObserver &observer_;
+            std::atomic<int> frames_{0};
+            std::atomic<uint64_t> peak_rss_{0};
+            int total_frames_ = 0;
+            std::mutex mutex_; // Serializes the callbacks
+            std::chrono::steady_clock::time_point next_report_;
+        };
+
+        // Memory budget (slide_detector_memory.cpp).
+        // Bytes for decoded frames in flight / for captured keyframes; 0 = unlimited.
+        size_t frame_memory_budget() const;
+        size_t keyframe_memory_budget() const;
+
+        // Writes the slide image to the spill directory (file name starts with `prefix`, then the frame
+        // index and `encoding`) and drops it from memory
+        void spill_slide(CapturedSlide &slide, const std::string &encoding, const std::string &prefix) const;
+
+        // Keeps the slide image if it fits into the keyframe budget next to the held_bytes already kept
+        // (and counts it), otherwise spills it. No-op without a budget.
+        void budget_keyframe(CapturedSlide &slide, const std::string &encoding, const std::string &prefix,
+                             size_t &held_bytes) const;
+
+        // Spill file name prefix unique to one process_video_with_frames call
+        static std::string make_spill_prefix();
+
+        // process_video_with_frames without the cache
+        std::vector<CapturedSlide> capture_slides(const VideoSource &video, const FrameCaptureOptions &options,
+                                                  ScanStats *stats, ScanReporter *reporter) const;
+
+        // Reference slide that new frames are compared against.
+        // Immutable once published, so worker threads can share it without locking.
+        struct ReferenceSlide
+        {
+            cv::Mat edges;       // Empty with ChangeMetric::PackedTiles
+            PackedEdges packed;  // Only with ChangeMetric::PackedTiles
+            cv::Mat thumb;
+            cv::UMat u_edges;    // ComputeBackend::OpenCL (host fields above are empty then)
+            cv::UMat u_thumb;
+        };
+        using ReferencePtr = std::shared_ptr<const ReferenceSlide>;
+
+        // Result of analyzing one frame against a reference.
+        // The Mats are reused from frame to frame; has_* say whether they belong to the current frame.
+        struct FrameAnalysis
+        {
+            ReferencePtr reference; // Reference the scores below were computed against
+            cv::Mat thumb;          // Coarse thumbnail (only when the coarse stage is enabled)
+            cv::Mat edges;          // Edge map (not computed if the coarse stage decided "static")
+            PackedEdges packed;     // Packed edge map (ChangeMetric::PackedTiles)
+            cv::UMat u_thumb;       // ComputeBackend::OpenCL versions of thumb / edges
+            cv::UMat u_edges;
+            bool has_thumb = false;
+            bool has_edges = false;
+            bool has_packed = false;
+            bool is_static = false; // Coarse stage: no change compared to the reference
+            double change_score = 1.0;
+
+            // Start a new frame, keeping the buffers
+            void reset()
+            {
+                reference.reset();
+                has_thumb = has_edges = has_packed = is_static = false;
+                change_score = 1.0;
+            }
+        };
+
+        // One specialized analyze_frame variant (slide_detector_kernels.cpp)
+        using AnalyzeKernel = void (SlideDetector::*)(const cv::Mat &, const ReferencePtr &, FrameAnalysis &,
+                                                      Workspace &) const;
+
+        // Scratch buffers for one analysis thread.
+        // Sized on the first frame and reused afterwards, so the steady-state loop doesn't allocate.
+        // One per scan / worker thread (not per detector), to keep SlideDetector reentrant.
+        struct Workspace
+        {
+            cv::Mat cropped; // View of the include area of the current frame
+            cv::Mat resized;
+            cv::Mat gray;
+            cv::Mat blurred;
+            cv::Mat edges; // Canny output, before dilation
+            cv::Mat small; // Thumbnail before gray conversion
+            cv::Mat diff;
+            std::vector<std::vector<cv::Point>> contours;
+            std::vector<int> tile_counts; // ChangeMetric::Tiles
+            std::vector<uint64_t> packed_rows; // Row buffer of dilate_packed_edges (ChangeMetric::PackedTiles)
+
+            // ComputeBackend::OpenCL device buffers
+            cv::UMat u_frame;
+            cv::UMat u_resized;
+            cv::UMat u_gray;
+            cv::UMat u_blurred;
+            cv::UMat u_edges;
+            cv::UMat u_small;
+            cv::UMat u_diff;
+            cv::UMat u_tiles;
+
+            // Analyzed part of the frame (the scan's AnalysisRegion) and its geometry for the current size
+            AnalysisRegion region;
+            std::vector<cv::Rect> exclude_rects; // Exclude regions in pixels of the last masked image
+            cv::Size coverage_size;
+            double coverage = 1.0;               // Not-excluded fraction of the include area at coverage_size
+            AnalyzeKernel kernel = nullptr;      // Picked from the settings and `region` on the first frame
+
+            ScanStats stats; // Counters / stage timings of this thread, merged into the scan's stats at the end
+        };
+
+        // State of the reference-comparison state machine (one per scan)
+        struct DetectionState
+        {
+            ReferencePtr reference;     // Last saved slide (nullptr before the first frame)
+            double last_slide_time = 0; // Timestamp of the last saved slide
+            std::vector<SlideSegment> segments;
+            std::vector<PackedEdges> occupancy; // Per segment, only with revisit_history_ (for re-tagging merges)
+            RevisitIndex revisits;
+            NoiseFloor noise;                   // Scores seen so far (adaptive threshold)
+            AnalysisRegion region;              // Copied into the Workspaces of the scan
+            ScanStats stats;                    // Merged Workspace stats of the scan
+            ScanReporter *reporter = nullptr;   // Counts the decoded frames (progress); not owned
+        };
+
+        // State of the streaming API between push_frame calls
+        struct StreamState
+        {
+            DetectionState detection;
+            int next_frame_index = 0;         // frame_index of the next pushed frame
+            double next_analysis_time = 0.0;  // target_analysis_fps: analyze no earlier than this
+            double last_timestamp = 0.0;
+            FrameAnalysis analysis;
+            Workspace workspace;
+        };
+        std::unique_ptr<StreamState> stream_;
+
+        // Number of frames to advance between analyzed frames for a video with this FPS
+        int effective_stride(double video_fps) const;
+
+        // Number of threads process_video will actually use
+        int resolved_num_threads() const;
+
+        // Decode loop of get_frames: calls on_frame(slot, frame) for every requested index that exists,
+        // in ascending frame order. Every decoded frame is a new Mat, so it may be kept.
+        void visit_frames(cv::VideoCapture &cap, const std::vector<int> &frame_indices,
+                          const std::function<void(size_t, const cv::Mat &)> &on_frame) const;
+
+        // Shared detection loop of process_video / process_video_with_frames.
+        // The scans add their counters / timings to *stats if it is set, and count frames in *reporter.
+        // *region receives the analyzed region of the scan before the first on_slide call.
+        // Without needs_frames on_slide only reports segments: it may get an empty frame, and the
+        // chunked scan neither keeps nor re-decodes slide frames for it.
+        std::vector<SlideSegment> scan_video(const VideoSource &video, const SlideCallback &on_slide,
+                                             bool needs_frames, ScanStats *stats, ScanReporter *reporter,
+                                             AnalysisRegion *region = nullptr) const;
+
+        // Serial, pipelined and chunked implementations of scan_video (same results)
+        std::vector<SlideSegment> scan_serial(cv::VideoCapture &cap, double fps, const AnalysisRegion &region,
+                                              const SlideCallback &on_slide, ScanStats *stats,
+                                              ScanReporter *reporter) const;
+        std::vector<SlideSegment> scan_pipelined(cv::VideoCapture &cap, double fps, int num_threads,
+                                                 const AnalysisRegion &region, const SlideCallback &on_slide,
+                                                 ScanStats *stats, ScanReporter *reporter) const;
+        std::vector<SlideSegment> scan_chunked(const VideoSource &video, double fps, int total_frames,
+                                               int num_chunks, const AnalysisRegion &region,
+                                               const SlideCallback &on_slide, bool needs_frames,
+                                               ScanStats *stats, ScanReporter *reporter) const;
+
+        // cap.grab() / cap.retrieve() timed as ScanStage::Decode / ScanStage::Convert
+        static bool timed_grab(cv::VideoCapture &cap, ScanStats &stats);
+        static bool timed_retrieve(cv::VideoCapture &cap, cv::Mat &frame, ScanStats &stats);
+
+        // Serial loop over frames [begin_frame, end_frame) of `cap` (end_frame < 0 = until EOF),
+        // continuing from `state`. The capture must be positioned at begin_frame.
+        // If converge_with is set, stops at the first emitted segment whose frame also starts a segment
+        // in *converge_with: from there on both runs have the same state. Returns true in that case.
+        bool scan_range(cv::VideoCapture &cap, double fps, int begin_frame, int end_frame, DetectionState &state,
+                        const SlideCallback &on_slide, const std::vector<SlideSegment> *converge_with) const;
+
+        // Include area of `frame` at the analysis scale: ws.cropped (a view) or ws.resized (ScanStage::Resize)
+        const cv::Mat &prepare_input(const cv::Mat &frame, Workspace &ws) const;
+
+        // Fills in analysis for `frame` against `reference`. Reuses the thumbnail / edges already
+        // present in `analysis`, so it can be called again when the reference changed (pipeline).
+        void analyze_frame(const cv::Mat &frame, const ReferencePtr &reference, FrameAnalysis &analysis,
+                           Workspace &ws) const;
+
+        // ComputeBackend::OpenCL version of analyze_frame (fills u_thumb / u_edges)
+        void analyze_frame_ocl(const cv::Mat &frame, const ReferencePtr &reference, FrameAnalysis &analysis,
+                               Workspace &ws) const;
+
+        // CPU versions of analyze_frame, one per metric / coarse stage / exclude mask policy
+        // (defined and instantiated in slide_detector_kernels.cpp only)
+        template <class Metric, class Coarse, class Mask>
+        void analyze_frame_cpu(const cv::Mat &frame, const ReferencePtr &reference, FrameAnalysis &analysis,
+                               Workspace &ws) const;
+
+        // The analyze_frame variant for the current settings and a scan over `region`
+        AnalyzeKernel select_analyze_kernel(const AnalysisRegion &region) const;
+
+        // Edge map of the analysis on the host: analysis.edges, or downloaded (OpenCL) / unpacked
+        // (PackedTiles) into `buffer`
+        const cv::Mat &host_edge_map(const FrameAnalysis &analysis, cv::Mat &buffer) const;
+
+        // Empty state for a new scan: the first frame can become a slide, revisit tracking per settings
+        DetectionState make_detection_state(const AnalysisRegion &region) const;
+
+        // Give merged segments their slide ids / revisit tags again, in order (chunked scans)
+        void tag_revisits(std::vector<SlideSegment> &segments, std::vector<PackedEdges> &occupancy) const;
+
+        // Change score a frame must exceed now: min_area_ratio, or the adaptive one once warmed up
+        double trigger_threshold(const DetectionState &state) const;
+
+        // Decision stage: emits a segment and updates the reference if this frame is a new slide.
+        // Returns true if a segment was emitted.
+        bool apply_decision(DetectionState &state, int frame_idx, double timestamp, FrameAnalysis &analysis) const;
+
+        // 1. Converts frame to B&W contours (Canny Edge Detection) into `edges`
+        void compute_edge_map(const cv::Mat &frame, Workspace &ws, cv::Mat &edges) const;
+        // Gray, blur and Canny of compute_edge_map, without the dilation (result in ws.edges)
+        void detect_edges(const cv::Mat &frame, Workspace &ws) const;
 
         // 2. Compares two contour frames and returns percentage of changed area
-        double calculate_change_metric(const cv::Mat &edges1, const cv::Mat &edges2);
+        double calculate_change_metric(const cv::Mat &edges1, const cv::Mat &edges2, Workspace &ws) const;
+
+        // Fraction of changed area from the bounding rects of the contours in `diff`
+        double contour_change_ratio(const cv::Mat &diff, Workspace &ws) const;
+
+        // Fills changed_regions / is_build_up of a new slide with edge map `edges` (analysis scale,
+        // include area of `region`) from its difference with the reference slide
+        void describe_change(const ReferenceSlide &reference, const cv::Mat &edges, const AnalysisRegion &region,
+                             SlideSegment &segment) const;
+
+        // Region of interest (slide_detector_region.cpp)
+        // Pixel rectangle of a fractional region in an image of `size` (clipped, at least 1x1)
+        static cv::Rect region_to_pixels(const cv::Rect2d &region, cv::Size size);
+        // Blank the exclude regions of `image`, an image of the include area (thumbnail, edge map)
+        void mask_excluded(cv::Mat &image, Workspace &ws) const;
+        void mask_excluded(cv::UMat &image, Workspace &ws) const;
+        void mask_excluded(PackedEdges &edges, Workspace &ws) const;
+        // Change score of a masked image of `size` relative to the analyzed (not excluded) area
+        double normalize_to_coverage(double score, cv::Size size, Workspace &ws) const;
+
+        // 3. Coarse stage: tiny grayscale thumbnail and its mean absolute difference
+        void compute_thumbnail(const cv::Mat &frame, Workspace &ws, cv::Mat &thumb) const;
+        double calculate_thumbnail_diff(const cv::Mat &thumb1, const cv::Mat &thumb2) const;
     };
 
 } // namespace ai_interview
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ai_interview
+{
+    /**
+     * @brief Fixed-size work-stealing thread pool.
+     * Every worker has its own task deque. Tasks posted from outside the pool are spread round-robin,
+     * tasks posted from a worker go to that worker's deque; an idle worker takes tasks from the
+     * other deques, so a few long tasks don't leave the rest of the workers waiting behind them.
+     */
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        /**
+         * @param num_threads Number of workers (0 = hardware concurrency).
+         */
+        explicit ThreadPool(int num_threads = 0);
+
+        // Runs the tasks that are still queued, then joins the workers
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        int size() const { return static_cast<int>(workers_.size()); }
+
+        /**
+         * @brief Queue a task. Exceptions escaping it are dropped (use submit to get them).
+         */
+        void post(Task task);
+
+        /**
+         * @brief Queue a callable and get its result (or exception) through a future.
+         */
+        template <class F>
+        std::future<std::invoke_result_t<std::decay_t<F>>> submit(F &&f)
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+            std::future<Result> result = task->get_future();
+            post([task]()
+                 { (*task)(); });
+            return result;
+        }
+
+        /**
+         * @brief Block until no task is queued or running.
+         */
+        void wait_idle();
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void worker_loop(int index);
+
+        // Takes the oldest task of worker `index`, or steals the oldest one of another worker
+        bool take_task(int index, Task &task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> workers_;
+
+        // Sleeping / idle bookkeeping. pending_ counts queued tasks not yet claimed by a worker:
+        // a worker claims one before it looks for it, so it always finds a task once it has a claim.
+        std::mutex mutex_;
+        std::condition_variable work_available_;
+        std::condition_variable idle_;
+        size_t pending_ = 0;
+        size_t running_ = 0;
+        bool stopping_ = false;
+        size_t next_queue_ = 0; // Round-robin target for tasks posted from outside the pool
+    };
+
+} // namespace ai_interview
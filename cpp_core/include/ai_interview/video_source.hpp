@@ -0,0 +1,97 @@
+#pragma once
+
+#include <opencv2/videoio.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ai_interview
+{
+    // from_reader: bytes pulled per read() call while a pipe is copied into memory
+    constexpr size_t VIDEO_SOURCE_READ_CHUNK = 1024 * 1024;
+
+    /**
+     * @brief Where a video is read from: a file path, a memory buffer or a read/seek callback.
+     * Implicitly built from a path, so every API that took a path still takes one.
+     *
+     * Memory and callback sources are handed to OpenCV as a cv::IStreamReader (OpenCV 4.11+,
+     * FFmpeg backend): nothing is written to disk and a memory buffer is not copied. With an older
+     * OpenCV (or a backend without stream support) the bytes are copied once into an anonymous
+     * in-memory file (Linux memfd) shared by every copy of the source.
+     *
+     * Copies are cheap and share the buffer / callbacks.
+     */
+    class VideoSource
+    {
+    public:
+        // Same contract as cv::IStreamReader: bytes read (0 at the end), new position (-1 on error)
+        using ReadFn = std::function<long long(char *buffer, long long size)>;
+        using SeekFn = std::function<long long(long long offset, int origin)>; // origin: SEEK_SET / CUR / END
+
+        enum class Kind
+        {
+            File,
+            Memory,
+            Reader
+        };
+
+        VideoSource(const std::string &path);
+        VideoSource(const char *path);
+
+        /**
+         * @brief Video held in memory (not copied). `owner` keeps the bytes alive as long as the source.
+         */
+        static VideoSource from_memory(const void *data, size_t size, std::shared_ptr<const void> owner = nullptr);
+
+        /**
+         * @brief Video read through callbacks. Without `seek` (a pipe, an upload stream) the stream is
+         * read into memory right away, since demuxers need to seek. With `seek` it is read in place:
+         * every open rewinds it, so it must not be scanned by two threads at once (no chunked scan).
+         */
+        static VideoSource from_reader(ReadFn read, SeekFn seek = nullptr);
+
+        Kind kind() const;
+        bool is_file() const { return kind() == Kind::File; }
+
+        // File path; empty for the other kinds
+        const std::string &path() const;
+
+        // Bytes of a memory source (nullptr / 0 for the other kinds)
+        const uint8_t *data() const;
+        size_t size() const;
+
+        /**
+         * @brief Text for error messages: the path, or what kind of stream it is.
+         */
+        std::string description() const;
+
+        /**
+         * @brief Open the video on `cap` (params as for cv::VideoCapture::open).
+         * @return false if no backend could open it with these params.
+         */
+        bool open(cv::VideoCapture &cap, const std::vector<int> &params = {}) const;
+
+        /**
+         * @brief A path other libraries can open (GStreamer filesrc): the file itself, or the in-memory
+         * file of a memory / callback source when OpenCV has no stream input. Empty otherwise.
+         */
+        std::string file_path() const;
+
+        /**
+         * @brief Whether several captures can read the source at the same time (chunked scan).
+         * False for a seekable callback source that is read in place.
+         */
+        bool supports_concurrent_open() const;
+
+    private:
+        struct Data;
+
+        explicit VideoSource(std::shared_ptr<Data> data);
+
+        std::shared_ptr<Data> data_;
+    };
+
+} // namespace ai_interview
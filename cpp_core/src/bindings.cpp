@@ -1,33 +1,215 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>   // For automatic std::vector conversion
 #include <pybind11/numpy.h> // For working with numpy arrays
+#include <pybind11/functional.h> // Python callables as std::function (engine callbacks)
+#include "ai_interview/detection_engine.hpp"
 #include "ai_interview/slide_detector.hpp"
+#include "ai_interview/signal_index.hpp"
+#include "ai_interview/video_source.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <tuple>
 
 namespace py = pybind11;
 
 // --- Helper function for converting cv::Mat -> numpy array ---
 // OpenCV stores data in BGR, Python usually wants RGB or also BGR.
 // We return "as is", Python will figure it out.
-py::array_t<uint8_t> mat_to_numpy(const cv::Mat &mat)
+// Zero-copy: the Mat header is moved to the heap and owned by a capsule that is the array's base,
+// so numpy holds the refcounted OpenCV buffer directly (no 6 MB memcpy per 1080p frame).
+// Note: Mats that share one buffer (e.g. duplicate indices in get_frames) give arrays sharing memory.
+py::array_t<uint8_t> mat_to_numpy(cv::Mat mat)
 {
     if (mat.empty())
     {
         return py::array_t<uint8_t>();
     }
 
+    auto *owner = new cv::Mat(std::move(mat));
+    py::capsule base(owner, [](void *p)
+                     { delete reinterpret_cast<cv::Mat *>(p); });
+
     // Define array shape (height, width, channels)
-    std::vector<ssize_t> shape = {mat.rows, mat.cols};
-    std::vector<ssize_t> strides = {mat.step[0], mat.step[1]};
+    std::vector<ssize_t> shape = {owner->rows, owner->cols};
+    std::vector<ssize_t> strides = {static_cast<ssize_t>(owner->step[0]), static_cast<ssize_t>(owner->step[1])};
+
+    if (owner->channels() > 1)
+    {
+        shape.push_back(owner->channels());
+        strides.push_back(static_cast<ssize_t>(owner->elemSize1()));
+    }
+
+    return py::array_t<uint8_t>(shape, strides, owner->data, base);
+}
+
+// --- Helper function for wrapping a numpy array as cv::Mat (no copy) ---
+// Accepts HxW (gray) or HxWxC uint8 arrays. The Mat is only valid while the array is alive.
+using numpy_frame = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+
+cv::Mat numpy_to_mat(const numpy_frame &array)
+{
+    if (array.ndim() != 2 && array.ndim() != 3)
+    {
+        throw std::invalid_argument("Expected HxW or HxWxC uint8 array");
+    }
+
+    int channels = array.ndim() == 3 ? static_cast<int>(array.shape(2)) : 1;
+    return cv::Mat(static_cast<int>(array.shape(0)), static_cast<int>(array.shape(1)),
+                   CV_8UC(channels), const_cast<uint8_t *>(array.data()));
+}
+
+// --- Region rectangles <-> (x, y, width, height) tuples in fractions of the frame ---
+using region_tuple = std::tuple<double, double, double, double>;
+
+region_tuple rect_to_tuple(const cv::Rect2d &r)
+{
+    return {r.x, r.y, r.width, r.height};
+}
+
+cv::Rect2d tuple_to_rect(const region_tuple &t)
+{
+    return cv::Rect2d(std::get<0>(t), std::get<1>(t), std::get<2>(t), std::get<3>(t));
+}
+
+std::vector<region_tuple> rects_to_tuples(const std::vector<cv::Rect2d> &rects)
+{
+    std::vector<region_tuple> result;
+    result.reserve(rects.size());
+    for (const auto &r : rects)
+        result.push_back(rect_to_tuple(r));
+    return result;
+}
+
+// Long-running native calls release the GIL, so other Python threads (FastAPI, thread pools)
+// keep running while a video is scanned. SlideDetector is safe to use from several threads.
+// Return values are converted to Python objects after the GIL is taken back.
+using release_gil = py::call_guard<py::gil_scoped_release>;
 
-    if (mat.channels() > 1)
+// ScanObserver callbacks. pybind11 takes the GIL only for the duration of each call
+using SegmentCallback = std::function<void(const ai_interview::SlideSegment &)>;
+using CapturedSlideCallback = std::function<void(const ai_interview::CapturedSlide &)>;
+using ProgressCallback = std::function<void(const ai_interview::ScanProgress &)>;
+
+// --- SlideDetectionEngine helpers ---
+// Handle of a submitted video (std::future can't be returned to Python)
+struct VideoJob
+{
+    std::shared_future<ai_interview::VideoResult> future;
+};
+
+// Python callbacks take the GIL on the worker threads, so the engine must not be joined
+// while the deleting thread holds it
+struct EngineDeleter
+{
+    void operator()(ai_interview::SlideDetectionEngine *engine) const
     {
-        shape.push_back(mat.channels());
-        strides.push_back(mat.elemSize1());
+        py::gil_scoped_release release;
+        delete engine;
     }
+};
 
-    // Create numpy array that references Mat data or copies it
-    // In this case it's safer to copy the data so Python owns the memory
-    return py::array_t<uint8_t>(shape, strides, mat.data).attr("copy")();
+// text_regions = None: no text region extraction
+ai_interview::FrameCaptureOptions capture_options(int max_width, const std::string &encoding, int jpeg_quality,
+                                                  const ai_interview::TextRegionOptions *text_regions)
+{
+    ai_interview::FrameCaptureOptions options;
+    options.max_width = max_width;
+    options.encoding = encoding;
+    options.jpeg_quality = jpeg_quality;
+    if (text_regions)
+    {
+        options.text_regions = true;
+        options.text = *text_regions;
+    }
+    return options;
+}
+
+// --- VideoSource helpers ---
+// Memory / stream sources keep Python objects alive. They may be released on a native thread
+// (last copy of the source dropped there), so the deleters take the GIL.
+
+// Zero-copy view of any C-contiguous buffer (bytes, bytearray, memoryview, numpy uint8 array).
+// The buffer stays exported while the source lives, so a bytearray can't be resized under the scan.
+ai_interview::VideoSource memory_source(const py::buffer &buffer)
+{
+    auto *view = new Py_buffer();
+    if (PyObject_GetBuffer(buffer.ptr(), view, PyBUF_C_CONTIGUOUS) != 0)
+    {
+        delete view;
+        throw py::error_already_set();
+    }
+    std::shared_ptr<const void> owner(view, [](Py_buffer *v)
+                                      {
+        py::gil_scoped_acquire gil;
+        PyBuffer_Release(v);
+        delete v; });
+    return ai_interview::VideoSource::from_memory(view->buf, static_cast<size_t>(view->len), std::move(owner));
+}
+
+// File-like object (read / readinto, seek). The callbacks run on the decoder threads with the GIL
+// released; Python exceptions can't cross the demuxer, so they are reported and end the stream.
+ai_interview::VideoSource reader_source(py::object file)
+{
+    const bool has_readinto = py::hasattr(file, "readinto");
+    const bool seekable = py::hasattr(file, "seek") &&
+                          (!py::hasattr(file, "seekable") || file.attr("seekable")().cast<bool>());
+    std::shared_ptr<py::object> handle(new py::object(std::move(file)), [](py::object *p)
+                                       {
+        py::gil_scoped_acquire gil;
+        delete p; });
+
+    ai_interview::VideoSource::ReadFn read = [handle, has_readinto](char *buffer, long long size) -> long long
+    {
+        py::gil_scoped_acquire gil;
+        try
+        {
+            if (has_readinto)
+            {
+                py::object count = handle->attr("readinto")(py::memoryview::from_memory(buffer, static_cast<ssize_t>(size)));
+                return count.is_none() ? 0 : count.cast<long long>();
+            }
+            py::buffer data = handle->attr("read")(size);
+            py::buffer_info info = data.request();
+            const long long count = std::min(size, static_cast<long long>(info.size * info.itemsize));
+            std::memcpy(buffer, info.ptr, static_cast<size_t>(count));
+            return count;
+        }
+        catch (py::error_already_set &e)
+        {
+            e.discard_as_unraisable("VideoSource read");
+            return 0;
+        }
+        catch (const std::exception &)
+        {
+            return 0; // read() returned something that is not a buffer
+        }
+    };
+
+    ai_interview::VideoSource::SeekFn seek = nullptr;
+    if (seekable)
+    {
+        seek = [handle](long long offset, int origin) -> long long
+        {
+            py::gil_scoped_acquire gil;
+            try
+            {
+                return handle->attr("seek")(offset, origin).cast<long long>();
+            }
+            catch (py::error_already_set &e)
+            {
+                e.discard_as_unraisable("VideoSource seek");
+                return -1;
+            }
+            catch (const std::exception &)
+            {
+                return -1;
+            }
+        };
+    }
+    return ai_interview::VideoSource::from_reader(std::move(read), std::move(seek));
 }
 
 // --- Module definition ---
@@ -40,20 +222,439 @@ PYBIND11_MODULE(ai_interview_cpp, m)
         .def_readwrite("frame_index", &ai_interview::SlideSegment::frame_index)
         .def_readwrite("timestamp_sec", &ai_interview::SlideSegment::timestamp_sec)
         .def_readwrite("change_ratio", &ai_interview::SlideSegment::change_ratio)
+        .def_readwrite("slide_id", &ai_interview::SlideSegment::slide_id)
+        .def_readwrite("is_revisit", &ai_interview::SlideSegment::is_revisit)
+        .def_property_readonly("changed_regions", [](const ai_interview::SlideSegment &s)
+                               { return rects_to_tuples(s.changed_regions); },
+                               "Merged changed areas since the previous slide, (x, y, width, height) in fractions of the frame")
+        .def_readwrite("is_build_up", &ai_interview::SlideSegment::is_build_up,
+                       "Previous slide kept with content added: only changed_regions is new")
         .def("__repr__", [](const ai_interview::SlideSegment &s)
              { return "<SlideSegment frame=" + std::to_string(s.frame_index) +
                       " time=" + std::to_string(s.timestamp_sec) + ">"; });
 
-    // 2. Bind SlideDetector class
+    py::enum_<ai_interview::ChangeMetric>(m, "ChangeMetric")
+        .value("CONTOURS", ai_interview::ChangeMetric::Contours)
+        .value("TILES", ai_interview::ChangeMetric::Tiles)
+        .value("PACKED_TILES", ai_interview::ChangeMetric::PackedTiles);
+
+    py::enum_<ai_interview::ComputeBackend>(m, "ComputeBackend")
+        .value("CPU", ai_interview::ComputeBackend::CPU)
+        .value("OPENCL", ai_interview::ComputeBackend::OpenCL);
+
+    py::enum_<ai_interview::DecodeAcceleration>(m, "DecodeAcceleration")
+        .value("NONE", ai_interview::DecodeAcceleration::None)
+        .value("ANY", ai_interview::DecodeAcceleration::Any)
+        .value("D3D11", ai_interview::DecodeAcceleration::D3D11)
+        .value("VAAPI", ai_interview::DecodeAcceleration::VAAPI)
+        .value("MFX", ai_interview::DecodeAcceleration::MFX);
+
+    py::class_<ai_interview::DecodeInfo>(m, "DecodeInfo")
+        .def_readonly("backend", &ai_interview::DecodeInfo::backend)
+        .def_readonly("acceleration", &ai_interview::DecodeInfo::acceleration)
+        .def_readonly("device", &ai_interview::DecodeInfo::device)
+        .def_readonly("fallback", &ai_interview::DecodeInfo::fallback)
+        .def("__repr__", [](const ai_interview::DecodeInfo &d)
+             { return "<DecodeInfo backend=" + d.backend +
+                      " hw=" + std::to_string(static_cast<int>(d.acceleration)) +
+                      " device=" + std::to_string(d.device) + ">"; });
+
+    // Video input: every `video_path` argument also takes bytes / a buffer (decoded from memory)
+    // or a VideoSource
+    py::enum_<ai_interview::VideoSource::Kind>(m, "VideoSourceKind")
+        .value("FILE", ai_interview::VideoSource::Kind::File)
+        .value("MEMORY", ai_interview::VideoSource::Kind::Memory)
+        .value("READER", ai_interview::VideoSource::Kind::Reader);
+
+    py::class_<ai_interview::VideoSource>(m, "VideoSource")
+        // Buffer first: the std::string caster would also accept bytes, as a path
+        .def(py::init(&memory_source), "Video held in memory (zero-copy)", py::arg("data"))
+        .def(py::init<const std::string &>(), "Video file", py::arg("path"))
+        .def_static("from_memory", &memory_source,
+                    "Video held in a buffer: bytes, bytearray, memoryview, numpy uint8 array (zero-copy)",
+                    py::arg("data"))
+        .def_static("from_reader", &reader_source,
+                    "Video read from a file-like object: in place if it is seekable, otherwise read into memory first",
+                    py::arg("file"))
+        .def_property_readonly("kind", &ai_interview::VideoSource::kind)
+        .def_property_readonly("size", &ai_interview::VideoSource::size, "Bytes of a memory source (0 otherwise)")
+        .def("__repr__", [](const ai_interview::VideoSource &source)
+             { return "<VideoSource " + source.description() + ">"; });
+    py::implicitly_convertible<py::buffer, ai_interview::VideoSource>();
+    py::implicitly_convertible<py::str, ai_interview::VideoSource>();
+
+    // Hot-path instrumentation: fill a ScanStats by passing it as `stats=` to process_video*
+    py::class_<ai_interview::StageStats>(m, "StageStats")
+        .def_readonly("count", &ai_interview::StageStats::count)
+        .def_readonly("total_sec", &ai_interview::StageStats::total_sec)
+        .def_readonly("max_sec", &ai_interview::StageStats::max_sec)
+        .def_property_readonly("mean_sec", &ai_interview::StageStats::mean_sec)
+        .def_readonly("histogram", &ai_interview::StageStats::histogram,
+                      "Counts per bucket, bucket i = durations below bucket_bounds_sec()[i]")
+        .def_static("bucket_bounds_sec", []()
+                    {
+            std::vector<double> bounds;
+            for (int i = 0; i < ai_interview::STAGE_HISTOGRAM_BUCKETS; i++)
+                bounds.push_back(ai_interview::StageStats::bucket_upper_bound_sec(i));
+            return bounds; }, "Upper bounds of the histogram buckets in seconds (last = inf)");
+
+    py::class_<ai_interview::ScanStats>(m, "ScanStats")
+        .def(py::init<>())
+        .def_readonly("frames_decoded", &ai_interview::ScanStats::frames_decoded)
+        .def_readonly("frames_skipped", &ai_interview::ScanStats::frames_skipped)
+        .def_readonly("frames_analyzed", &ai_interview::ScanStats::frames_analyzed)
+        .def_readonly("frames_static", &ai_interview::ScanStats::frames_static)
+        .def_readonly("slides", &ai_interview::ScanStats::slides)
+        .def_readonly("cache_hit", &ai_interview::ScanStats::cache_hit)
+        .def_readonly("wall_sec", &ai_interview::ScanStats::wall_sec)
+        .def_readonly("start_rss_bytes", &ai_interview::ScanStats::start_rss_bytes)
+        .def_readonly("peak_rss_bytes", &ai_interview::ScanStats::peak_rss_bytes)
+        .def_property_readonly("stages", [](const ai_interview::ScanStats &stats)
+                               {
+            // {"decode": StageStats, "convert": ..., ...}
+            std::map<std::string, ai_interview::StageStats> stages;
+            for (int i = 0; i < ai_interview::NUM_SCAN_STAGES; i++)
+                stages[ai_interview::scan_stage_name(static_cast<ai_interview::ScanStage>(i))] = stats.stages[i];
+            return stages; })
+        .def("__repr__", [](const ai_interview::ScanStats &stats)
+             { return "<ScanStats decoded=" + std::to_string(stats.frames_decoded) +
+                      " analyzed=" + std::to_string(stats.frames_analyzed) +
+                      " wall=" + std::to_string(stats.wall_sec) + "s" +
+                      " peak_rss=" + std::to_string(stats.peak_rss_bytes >> 20) + "MiB>"; });
+
+    // Progress reports of process_video* (on_progress)
+    py::class_<ai_interview::ScanProgress>(m, "ScanProgress")
+        .def_readonly("frames_processed", &ai_interview::ScanProgress::frames_processed)
+        .def_readonly("total_frames", &ai_interview::ScanProgress::total_frames)
+        .def_readonly("done", &ai_interview::ScanProgress::done)
+        .def_property_readonly("fraction", &ai_interview::ScanProgress::fraction);
+
+    // Analyzed part of the frame: (x, y, width, height) tuples in fractions of the frame size
+    py::class_<ai_interview::AnalysisRegion>(m, "AnalysisRegion")
+        .def_property_readonly("include", [](const ai_interview::AnalysisRegion &r)
+                               { return rect_to_tuple(r.include); })
+        .def_property_readonly("exclude", [](const ai_interview::AnalysisRegion &r)
+                               { return rects_to_tuples(r.exclude); })
+        .def("__repr__", [](const ai_interview::AnalysisRegion &r)
+             { return "<AnalysisRegion exclude=" + std::to_string(r.exclude.size()) + ">"; });
+
+    // Per-frame change signal for decode-free re-thresholding
+    py::class_<ai_interview::SignalIndex>(m, "SignalIndex")
+        .def_readonly("fps", &ai_interview::SignalIndex::fps)
+        .def_readonly("min_scene_duration", &ai_interview::SignalIndex::min_scene_duration)
+        .def_readonly("min_area_ratio", &ai_interview::SignalIndex::min_area_ratio)
+        .def("__len__", [](const ai_interview::SignalIndex &index)
+             { return index.records.size(); })
+        .def_property_readonly("frame_indices", [](const ai_interview::SignalIndex &index)
+                               {
+            std::vector<int> values;
+            values.reserve(index.records.size());
+            for (const auto &r : index.records)
+                values.push_back(r.frame_index);
+            return values; })
+        .def_property_readonly("timestamps", [](const ai_interview::SignalIndex &index)
+                               {
+            std::vector<double> values;
+            values.reserve(index.records.size());
+            for (const auto &r : index.records)
+                values.push_back(r.timestamp_sec);
+            return values; })
+        .def_property_readonly("change_scores", [](const ai_interview::SignalIndex &index)
+                               {
+            std::vector<double> values;
+            values.reserve(index.records.size());
+            for (const auto &r : index.records)
+                values.push_back(r.change_score);
+            return values; });
+
+    m.def("save_signal_index", &ai_interview::save_signal_index, "Save a SignalIndex (memory-mappable layout)",
+          py::arg("path"), py::arg("index"));
+    m.def("load_signal_index", &ai_interview::load_signal_index, "Load a SignalIndex saved by save_signal_index",
+          py::arg("path"), release_gil());
+    m.def("select_segments", &ai_interview::select_segments,
+          "Re-run slide selection on a SignalIndex for other thresholds (no decoding)",
+          py::arg("index"), py::arg("min_scene_duration_sec"), py::arg("min_area_ratio"));
+
+    // Text blocks of a slide, for OCR (extract_text_regions / process_video_with_frames)
+    py::class_<ai_interview::TextRegionOptions>(m, "TextRegionOptions")
+        .def(py::init([](bool deskew, bool binarize, int padding)
+                      {
+            ai_interview::TextRegionOptions options;
+            options.deskew = deskew;
+            options.binarize = binarize;
+            options.padding = padding;
+            return options; }),
+             py::arg("deskew") = true, py::arg("binarize") = false,
+             py::arg("padding") = ai_interview::DEFAULT_TEXT_REGION_PADDING)
+        .def_readwrite("deskew", &ai_interview::TextRegionOptions::deskew,
+                       "Rectify a slide filmed at an angle")
+        .def_readwrite("binarize", &ai_interview::TextRegionOptions::binarize,
+                       "Dark-on-white gray regions (Otsu) instead of BGR crops")
+        .def_readwrite("padding", &ai_interview::TextRegionOptions::padding,
+                       "Pixels added around every region");
+
+    py::class_<ai_interview::TextRegion>(m, "TextRegion")
+        .def_property_readonly("rect", [](const ai_interview::TextRegion &r)
+                               { return std::make_tuple(r.rect.x, r.rect.y, r.rect.width, r.rect.height); },
+                               "(x, y, width, height) in pixels of the slide crop")
+        .def_property_readonly("image", [](const ai_interview::TextRegion &r)
+                               { return mat_to_numpy(r.image); })
+        .def_property_readonly("encoded", [](const ai_interview::TextRegion &r)
+                               { return py::bytes(reinterpret_cast<const char *>(r.encoded.data()), r.encoded.size()); });
+
+    py::class_<ai_interview::SlideCrop>(m, "SlideCrop")
+        .def_property_readonly("corners", [](const ai_interview::SlideCrop &c)
+                               {
+            std::vector<std::tuple<float, float>> corners;
+            for (const auto &p : c.corners)
+                corners.emplace_back(p.x, p.y);
+            return corners; }, "Slide outline in frame pixels: top-left, top-right, bottom-right, bottom-left")
+        .def_readonly("deskewed", &ai_interview::SlideCrop::deskewed)
+        .def_property_readonly("slide", [](const ai_interview::SlideCrop &c)
+                               { return mat_to_numpy(c.slide); })
+        .def_readonly("regions", &ai_interview::SlideCrop::regions);
+
+    // 2. Bind CapturedSlide (segment + its image)
+    py::class_<ai_interview::CapturedSlide>(m, "CapturedSlide")
+        .def_readonly("segment", &ai_interview::CapturedSlide::segment)
+        .def_property_readonly("frame", [](const ai_interview::CapturedSlide &s)
+                               { return mat_to_numpy(s.frame); })
+        .def_property_readonly("encoded", [](const ai_interview::CapturedSlide &s)
+                               { return py::bytes(reinterpret_cast<const char *>(s.encoded.data()), s.encoded.size()); })
+        .def_readonly("text_regions", &ai_interview::CapturedSlide::text_regions,
+                      "Text blocks in reading order (only with text_regions options)")
+        .def_readonly("spill_path", &ai_interview::CapturedSlide::spill_path,
+                      "Image file of a slide spilled over the memory budget (\"\" = in frame / encoded); the caller deletes it");
+
+    py::class_<ai_interview::Thumbnail>(m, "Thumbnail")
+        .def_readonly("frame_index", &ai_interview::Thumbnail::frame_index)
+        .def_property_readonly("encoded", [](const ai_interview::Thumbnail &t)
+                               { return py::bytes(reinterpret_cast<const char *>(t.encoded.data()), t.encoded.size()); },
+                               "Encoded image (empty when written to output_dir or the frame doesn't exist)")
+        .def_readonly("path", &ai_interview::Thumbnail::path, "File written to output_dir (\"\" otherwise)");
+
+    py::class_<ai_interview::ThumbnailSet>(m, "ThumbnailSet")
+        .def_readonly("thumbnails", &ai_interview::ThumbnailSet::thumbnails, "Same order as the requested frames")
+        .def_property_readonly("sprite", [](const ai_interview::ThumbnailSet &t)
+                               { return py::bytes(reinterpret_cast<const char *>(t.sprite.data()), t.sprite.size()); },
+                               "Encoded sprite sheet (empty unless requested, or when written to output_dir)")
+        .def_readonly("sprite_path", &ai_interview::ThumbnailSet::sprite_path)
+        .def_readonly("sprite_columns", &ai_interview::ThumbnailSet::sprite_columns,
+                      "Thumbnail i is the tile at row i // columns, column i % columns")
+        .def_property_readonly("tile_size", [](const ai_interview::ThumbnailSet &t)
+                               { return std::make_tuple(t.tile_size.width, t.tile_size.height); },
+                               "(width, height) of one sprite tile");
+
+    // 3. Bind SlideDetector class
     py::class_<ai_interview::SlideDetector>(m, "SlideDetector")
         .def(py::init<double, double>(),
              py::arg("min_scene_duration_sec") = 2.0,
              py::arg("min_area_ratio") = 0.20)
-        .def("process_video", &ai_interview::SlideDetector::process_video,
-             "Scans video for slide transitions")
-        .def("get_frame", [](ai_interview::SlideDetector &self, const std::string &path, int idx)
+        .def_property("frame_stride", &ai_interview::SlideDetector::get_frame_stride,
+                      &ai_interview::SlideDetector::set_frame_stride,
+                      "Analyze every N-th frame (skipped frames are grabbed but not decoded to BGR)")
+        .def_property("target_analysis_fps", &ai_interview::SlideDetector::get_target_analysis_fps,
+                      &ai_interview::SlideDetector::set_target_analysis_fps,
+                      "Analyze ~N frames per second of video (0 = use frame_stride)")
+        .def_property("coarse_threshold", &ai_interview::SlideDetector::get_coarse_threshold,
+                      &ai_interview::SlideDetector::set_coarse_threshold,
+                      "Thumbnail mean-abs-diff (gray levels) below which a frame skips edge detection (0 = off)")
+        .def_property("num_threads", &ai_interview::SlideDetector::get_num_threads,
+                      &ai_interview::SlideDetector::set_num_threads,
+                      "Threads for process_video: 0 = all cores (decode/analyze pipeline), 1 = serial")
+        .def_property("num_chunks", &ai_interview::SlideDetector::get_num_chunks,
+                      &ai_interview::SlideDetector::set_num_chunks,
+                      "Scan long videos as K parallel time ranges with exact boundary merge (0/1 = off)")
+        .def_property("change_metric", &ai_interview::SlideDetector::get_change_metric,
+                      &ai_interview::SlideDetector::set_change_metric,
+                      "Change metric engine: ChangeMetric.CONTOURS (default), TILES (fused, faster) or PACKED_TILES (1-bit maps)")
+        .def_property("compute_backend", &ai_interview::SlideDetector::get_compute_backend,
+                      &ai_interview::SlideDetector::set_compute_backend,
+                      "Where frames are analyzed: ComputeBackend.CPU (default) or OPENCL (GPU via OpenCV T-API)")
+        .def_static("is_opencl_available", &ai_interview::SlideDetector::is_opencl_available,
+                    "True if OpenCV found an OpenCL device for ComputeBackend.OPENCL")
+        .def_property_readonly("analysis_kernel", &ai_interview::SlideDetector::get_analysis_kernel,
+                               "Specialized per-frame analysis picked by change_metric, coarse_threshold and the exclude regions, "
+                               "e.g. \"packed_tiles/coarse/whole_area\"")
+        .def_property("decode_acceleration", &ai_interview::SlideDetector::get_decode_acceleration,
+                      [](ai_interview::SlideDetector &self, ai_interview::DecodeAcceleration acceleration)
+                      { self.set_decode_acceleration(acceleration, self.get_decode_device()); },
+                      "Hardware video decoding: DecodeAcceleration.NONE (default, software), ANY, VAAPI, D3D11, MFX")
+        .def_property("decode_device", &ai_interview::SlideDetector::get_decode_device,
+                      [](ai_interview::SlideDetector &self, int device)
+                      { self.set_decode_acceleration(self.get_decode_acceleration(), device); },
+                      "Hardware decode device index (-1 = default)")
+        .def_property("reduced_decode", &ai_interview::SlideDetector::get_reduced_decode,
+                      &ai_interview::SlideDetector::set_reduced_decode,
+                      "Decode gray analysis-size frames via GStreamer; full-resolution frames only for slides")
+        .def_property("revisit_history", &ai_interview::SlideDetector::get_revisit_history,
+                      &ai_interview::SlideDetector::set_revisit_history,
+                      "Remember N distinct slides and tag returns to them (is_revisit, same slide_id); 0 = off")
+        .def_property("adaptive_threshold", &ai_interview::SlideDetector::get_adaptive_threshold,
+                      &ai_interview::SlideDetector::set_adaptive_threshold,
+                      "Trigger at median + N robust deviations of the video's change scores instead of "
+                      "min_area_ratio; 0 = off")
+        .def_property("include_region", [](const ai_interview::SlideDetector &self)
+                      { return rect_to_tuple(self.get_analysis_region().include); },
+                      [](ai_interview::SlideDetector &self, const region_tuple &region)
+                      { self.set_include_region(tuple_to_rect(region)); },
+                      "Analyzed slide area (x, y, width, height) in fractions of the frame (default: whole frame)")
+        .def_property_readonly("exclude_regions", [](const ai_interview::SlideDetector &self)
+                               { return rects_to_tuples(self.get_analysis_region().exclude); },
+                               "Ignored areas (x, y, width, height) in fractions of the frame")
+        .def("add_exclude_region", [](ai_interview::SlideDetector &self, double x, double y, double width, double height)
+             { self.add_exclude_region(cv::Rect2d(x, y, width, height)); },
+             "Ignore an area of the frame, e.g. a webcam overlay (fractions of the frame size)",
+             py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"))
+        .def("clear_exclude_regions", &ai_interview::SlideDetector::clear_exclude_regions, "Remove all exclude regions")
+        .def_property("auto_exclude_duration", &ai_interview::SlideDetector::get_auto_exclude_duration,
+                      &ai_interview::SlideDetector::set_auto_exclude_duration,
+                      "Seconds at the start of each video searched for a moving overlay to exclude (0 = off)")
+        .def("detect_analysis_region", &ai_interview::SlideDetector::detect_analysis_region,
+             "Configured region plus the overlays auto-detected in this video",
+             py::arg("video_path"), release_gil())
+        .def_property("cache_dir", &ai_interview::SlideDetector::get_cache_dir,
+                      &ai_interview::SlideDetector::set_cache_dir,
+                      "Directory of the on-disk result cache keyed by file fingerprint + settings (\"\" = off)")
+        .def_property("memory_budget", &ai_interview::SlideDetector::get_memory_budget,
+                      &ai_interview::SlideDetector::set_memory_budget,
+                      "Bytes per scan for frames in flight and captured keyframes; later keyframes are spilled to disk (0 = unlimited)")
+        .def_property("spill_dir", &ai_interview::SlideDetector::get_spill_dir,
+                      &ai_interview::SlideDetector::set_spill_dir,
+                      "Directory of slides spilled over the memory budget (\"\" = system temp directory)")
+        .def("build_signal_index", &ai_interview::SlideDetector::build_signal_index,
+             "Decode once and record the change signal of every sampled frame (see select_segments)",
+             py::arg("video_path"), release_gil())
+        .def("get_decode_info", &ai_interview::SlideDetector::get_decode_info,
+             "Open the video with the current decode settings and report the backend actually used",
+             py::arg("video_path"), release_gil())
+        .def("process_video", [](const ai_interview::SlideDetector &self, const ai_interview::VideoSource &video, ai_interview::ScanStats *stats, SegmentCallback on_segment, ProgressCallback on_progress, double progress_interval_sec)
+             {
+            ai_interview::ScanObserver observer;
+            observer.on_segment = std::move(on_segment);
+            observer.on_progress = std::move(on_progress);
+            observer.progress_interval_sec = progress_interval_sec;
+            return self.process_video(video, observer, stats); }, "Scans video for slide transitions (pass a ScanStats as stats to get counters / stage timings). "
+             "on_segment(segment) / on_progress(progress) are called during the scan, from native threads",
+             py::arg("video_path"), py::arg("stats") = py::none(), py::arg("on_segment") = nullptr,
+             py::arg("on_progress") = nullptr, py::arg("progress_interval_sec") = ai_interview::DEFAULT_PROGRESS_INTERVAL_SEC,
+             release_gil())
+        .def("process_video_with_frames", [](const ai_interview::SlideDetector &self, const ai_interview::VideoSource &video, int max_width, const std::string &encoding, int jpeg_quality, const ai_interview::TextRegionOptions *text_regions, ai_interview::ScanStats *stats, CapturedSlideCallback on_slide, ProgressCallback on_progress, double progress_interval_sec)
+             {
+            ai_interview::ScanObserver observer;
+            observer.on_slide = std::move(on_slide);
+            observer.on_progress = std::move(on_progress);
+            observer.progress_interval_sec = progress_interval_sec;
+            return self.process_video_with_frames(video, capture_options(max_width, encoding, jpeg_quality, text_regions), observer, stats); }, "Scans video for slide transitions and captures the image of every slide in the same pass. "
+             "on_slide(captured_slide) gets every slide as soon as it is final. "
+             "Pass a TextRegionOptions as text_regions to also get the text blocks of every slide",
+             py::arg("video_path"), py::arg("max_width") = 0, py::arg("encoding") = "", py::arg("jpeg_quality") = 95,
+             py::arg("text_regions") = py::none(), py::arg("stats") = py::none(), py::arg("on_slide") = nullptr, py::arg("on_progress") = nullptr,
+             py::arg("progress_interval_sec") = ai_interview::DEFAULT_PROGRESS_INTERVAL_SEC, release_gil())
+        .def("get_frame", [](const ai_interview::SlideDetector &self, const ai_interview::VideoSource &video, int idx)
+             {
+            // Custom wrapper for converting Mat -> Numpy (numpy needs the GIL, decoding doesn't)
+            cv::Mat frame;
+            {
+                py::gil_scoped_release release;
+                frame = self.get_frame(video, idx);
+            }
+            return mat_to_numpy(std::move(frame)); }, "Get specific video frame as numpy array")
+        .def("get_frames", [](const ai_interview::SlideDetector &self, const ai_interview::VideoSource &video, std::vector<int> indices)
              {
-            // Custom wrapper for converting Mat -> Numpy
-            cv::Mat frame = self.get_frame(path, idx);
-            return mat_to_numpy(frame); }, "Get specific video frame as numpy array");
+            // Opens the video once and decodes only the requested frames
+            std::vector<cv::Mat> frames;
+            {
+                py::gil_scoped_release release;
+                frames = self.get_frames(video, std::move(indices));
+            }
+            py::list result;
+            for (auto &frame : frames)
+                result.append(mat_to_numpy(std::move(frame)));
+            return result; }, "Get several video frames (list of numpy arrays, same order as indices)",
+             py::arg("video_path"), py::arg("frame_indices"))
+        .def("make_thumbnails", [](const ai_interview::SlideDetector &self, const ai_interview::VideoSource &video,
+                                   const std::vector<int> &indices, int width, const std::string &encoding, int quality,
+                                   bool sprite_sheet, int sprite_columns, const std::string &output_dir)
+             {
+            ai_interview::ThumbnailOptions options;
+            options.width = width;
+            options.encoding = encoding;
+            options.quality = quality;
+            options.sprite_sheet = sprite_sheet;
+            options.sprite_columns = sprite_columns;
+            options.output_dir = output_dir;
+            return self.make_thumbnails(video, indices, options); },
+             "Small encoded previews of frames (e.g. every slide) and optionally a sprite sheet, in one decode pass",
+             py::arg("video_path"), py::arg("frame_indices"),
+             py::arg("width") = ai_interview::DEFAULT_THUMBNAIL_WIDTH, py::arg("encoding") = ".jpg",
+             py::arg("quality") = ai_interview::DEFAULT_THUMBNAIL_QUALITY, py::arg("sprite_sheet") = false,
+             py::arg("sprite_columns") = ai_interview::DEFAULT_SPRITE_COLUMNS, py::arg("output_dir") = "",
+             release_gil())
+        .def("extract_text_regions", [](const ai_interview::SlideDetector &self, const numpy_frame &frame, const ai_interview::TextRegionOptions &options)
+             {
+            cv::Mat mat = numpy_to_mat(frame);
+            py::gil_scoped_release release;
+            return self.extract_text_regions(mat, options); }, "Cut the slide out of a frame (BGR numpy array) and find its text blocks, using the configured region",
+             py::arg("frame"), py::arg("options") = ai_interview::TextRegionOptions())
+        // Streaming API: detection while the recording is still growing
+        .def("begin", &ai_interview::SlideDetector::begin, "Start a new detection stream")
+        .def("push_frame", [](ai_interview::SlideDetector &self, const numpy_frame &frame, double timestamp_sec)
+             {
+            cv::Mat mat = numpy_to_mat(frame);
+            py::gil_scoped_release release;
+            return self.push_frame(mat, timestamp_sec); }, "Feed the next frame (BGR or gray numpy array); returns newly confirmed slides",
+             py::arg("frame"), py::arg("timestamp_sec"))
+        .def("finish", &ai_interview::SlideDetector::finish, "End the stream and return all its slides");
+
+    // 4. Batch processing: many videos on one shared worker pool
+    py::class_<ai_interview::VideoResult>(m, "VideoResult")
+        .def_readonly("video_path", &ai_interview::VideoResult::video_path)
+        .def_readonly("segments", &ai_interview::VideoResult::segments)
+        .def_readonly("slides", &ai_interview::VideoResult::slides)
+        .def_readonly("stats", &ai_interview::VideoResult::stats)
+        .def_readonly("error", &ai_interview::VideoResult::error)
+        .def_property_readonly("ok", &ai_interview::VideoResult::ok);
+
+    py::class_<VideoJob>(m, "VideoJob")
+        .def("done", [](const VideoJob &job)
+             { return job.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; },
+             "True once the video is processed")
+        .def("result", [](const VideoJob &job)
+             {
+            {
+                py::gil_scoped_release release;
+                job.future.wait();
+            }
+            return job.future.get(); }, "Wait for the video and return its VideoResult");
+
+    py::class_<ai_interview::SlideDetectionEngine, std::unique_ptr<ai_interview::SlideDetectionEngine, EngineDeleter>>(m, "SlideDetectionEngine")
+        .def(py::init<int, double, double>(),
+             py::arg("num_threads") = 0,
+             py::arg("min_scene_duration_sec") = 2.0,
+             py::arg("min_area_ratio") = 0.20)
+        .def_property_readonly("detector", py::overload_cast<>(&ai_interview::SlideDetectionEngine::detector),
+                               py::return_value_policy::reference_internal,
+                               "Settings used for every video (configure before submitting; num_threads is 1)")
+        .def_property_readonly("num_threads", &ai_interview::SlideDetectionEngine::get_num_threads)
+        .def("submit", [](ai_interview::SlideDetectionEngine &self, const std::string &path,
+                          ai_interview::SlideDetectionEngine::ResultCallback callback)
+             { return VideoJob{self.submit(path, std::move(callback)).share()}; },
+             "Queue a video; callback(result) runs on a worker thread when it is done",
+             py::arg("video_path"), py::arg("callback") = nullptr)
+        .def("submit_with_frames", [](ai_interview::SlideDetectionEngine &self, const std::string &path, int max_width, const std::string &encoding, int jpeg_quality, const ai_interview::TextRegionOptions *text_regions, ai_interview::SlideDetectionEngine::ResultCallback callback)
+             { return VideoJob{self.submit_with_frames(path, capture_options(max_width, encoding, jpeg_quality, text_regions), std::move(callback)).share()}; },
+             "Queue a video for process_video_with_frames",
+             py::arg("video_path"), py::arg("max_width") = 0, py::arg("encoding") = "", py::arg("jpeg_quality") = 95,
+             py::arg("text_regions") = py::none(), py::arg("callback") = nullptr)
+        .def("process_videos", &ai_interview::SlideDetectionEngine::process_videos,
+             "Process a batch (largest first) and return one VideoResult per path, in order",
+             py::arg("video_paths"), py::arg("callback") = nullptr, release_gil())
+        .def("process_videos_with_frames", [](ai_interview::SlideDetectionEngine &self, const std::vector<std::string> &paths, int max_width, const std::string &encoding, int jpeg_quality, const ai_interview::TextRegionOptions *text_regions, ai_interview::SlideDetectionEngine::ResultCallback callback)
+             { return self.process_videos_with_frames(paths, capture_options(max_width, encoding, jpeg_quality, text_regions), std::move(callback)); },
+             "Same as process_videos, capturing the image of every slide",
+             py::arg("video_paths"), py::arg("max_width") = 0, py::arg("encoding") = "", py::arg("jpeg_quality") = 95,
+             py::arg("text_regions") = py::none(), py::arg("callback") = nullptr, release_gil())
+        .def("wait_idle", &ai_interview::SlideDetectionEngine::wait_idle, "Wait until every submitted video is done",
+             release_gil());
 }
\ No newline at end of file
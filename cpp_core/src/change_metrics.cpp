@@ -0,0 +1,303 @@
+#include "ai_interview/change_metrics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        inline int popcount64(uint64_t v)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(v);
+#else
+            v = v - ((v >> 1) & 0x5555555555555555ULL);
+            v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+            v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<int>((v * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // Number of differing bytes in a[0..n) and b[0..n).
+        // 8 bytes per step: XOR, fold every byte to its lowest bit, popcount (SWAR, any CPU).
+        inline int count_changed(const uchar *a, const uchar *b, int n)
+        {
+            int count = 0;
+            int i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                uint64_t x, y;
+                std::memcpy(&x, a + i, sizeof(x));
+                std::memcpy(&y, b + i, sizeof(y));
+                uint64_t d = x ^ y;
+                d |= d >> 4;
+                d |= d >> 2;
+                d |= d >> 1;
+                count += popcount64(d & 0x0101010101010101ULL);
+            }
+            for (; i < n; i++)
+                count += a[i] != b[i];
+            return count;
+        }
+
+        // Adds the differing bytes of every tile of a row to tile_counts. With 16-pixel tiles one
+        // byte compare + movemask (x86) or compare + horizontal add (AArch64) covers a tile; AVX2
+        // does two tiles per step. SSE2 is part of x86-64, so default builds use it as well.
+        // The SWAR count_changed takes the border tile and other CPUs / tile sizes.
+        inline void count_changed_row(const uchar *a, const uchar *b, int cols, int *tile_counts)
+        {
+            int x = 0;
+            if constexpr (CHANGE_TILE_SIZE == 16)
+            {
+#if defined(__AVX2__)
+                for (; x + 32 <= cols; x += 32)
+                {
+                    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + x));
+                    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + x));
+                    const uint32_t changed = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+                    tile_counts[x / 16] += popcount64(changed & 0xFFFFu);
+                    tile_counts[x / 16 + 1] += popcount64(changed >> 16);
+                }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+                for (; x + 16 <= cols; x += 16)
+                {
+                    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x));
+                    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x));
+                    const uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+                    tile_counts[x / 16] += popcount64(~equal & 0xFFFFu);
+                }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+                for (; x + 16 <= cols; x += 16)
+                {
+                    const uint8x16_t changed = vmvnq_u8(vceqq_u8(vld1q_u8(a + x), vld1q_u8(b + x)));
+                    tile_counts[x / 16] += vaddvq_u8(vshrq_n_u8(changed, 7)); // 0xFF -> 1, at most 16
+                }
+#endif
+            }
+
+            // x is at a tile boundary here
+            for (; x < cols; x += CHANGE_TILE_SIZE)
+                tile_counts[x / CHANGE_TILE_SIZE] += count_changed(a + x, b + x, std::min(CHANGE_TILE_SIZE, cols - x));
+        }
+
+        // Border tiles are smaller: scale the dirty threshold by their area
+        inline bool is_dirty_tile(int changed, int tile_w, int tile_h)
+        {
+            return changed * CHANGE_TILE_SIZE * CHANGE_TILE_SIZE >= CHANGE_TILE_MIN_PIXELS * tile_w * tile_h;
+        }
+    } // namespace
+
+    double tile_change_ratio(const cv::Mat &edges1, const cv::Mat &edges2, std::vector<int> &tile_counts)
+    {
+        if (edges1.empty() || edges2.empty())
+            return 1.0;
+        if (edges1.size() != edges2.size() || edges1.type() != CV_8UC1 || edges2.type() != CV_8UC1)
+            throw std::invalid_argument("tile_change_ratio: edge maps must be CV_8UC1 of the same size");
+
+        const int rows = edges1.rows;
+        const int cols = edges1.cols;
+        const int tiles_x = (cols + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        const int tiles_y = (rows + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        tile_counts.resize(tiles_x);
+
+        int dirty_tiles = 0;
+        for (int ty = 0; ty < tiles_y; ty++)
+        {
+            std::fill(tile_counts.begin(), tile_counts.end(), 0);
+
+            const int y0 = ty * CHANGE_TILE_SIZE;
+            const int tile_h = std::min(CHANGE_TILE_SIZE, rows - y0);
+            for (int y = y0; y < y0 + tile_h; y++)
+                count_changed_row(edges1.ptr<uchar>(y), edges2.ptr<uchar>(y), cols, tile_counts.data());
+
+            for (int tx = 0; tx < tiles_x; tx++)
+            {
+                const int tile_w = std::min(CHANGE_TILE_SIZE, cols - tx * CHANGE_TILE_SIZE);
+                if (is_dirty_tile(tile_counts[tx], tile_w, tile_h))
+                    dirty_tiles++;
+            }
+        }
+
+        return static_cast<double>(dirty_tiles) / (tiles_x * tiles_y);
+    }
+
+    void pack_edges(const cv::Mat &edges, PackedEdges &packed)
+    {
+        if (edges.type() != CV_8UC1)
+            throw std::invalid_argument("pack_edges: edge map must be CV_8UC1");
+
+        packed.rows = edges.rows;
+        packed.cols = edges.cols;
+        packed.words_per_row = (edges.cols + 63) / 64;
+        packed.bits.assign(static_cast<size_t>(packed.rows) * packed.words_per_row, 0);
+
+        for (int y = 0; y < edges.rows; y++)
+        {
+            const uchar *src = edges.ptr<uchar>(y);
+            uint64_t *dst = packed.row(y);
+
+            int x = 0;
+            for (; x + 8 <= edges.cols; x += 8)
+            {
+                // Fold every byte to its lowest bit, then gather the 8 bits into one byte:
+                // multiplying by 0x0102040810204080 moves bit 8k to bit 56+k without collisions.
+                uint64_t v;
+                std::memcpy(&v, src + x, sizeof(v));
+                v |= v >> 4;
+                v |= v >> 2;
+                v |= v >> 1;
+                v &= 0x0101010101010101ULL;
+                uint64_t byte = (v * 0x0102040810204080ULL) >> 56;
+                dst[x / 64] |= byte << (x % 64);
+            }
+            for (; x < edges.cols; x++)
+            {
+                if (src[x])
+                    dst[x / 64] |= 1ULL << (x % 64);
+            }
+        }
+    }
+
+    void dilate_packed_edges(PackedEdges &packed, std::vector<uint64_t> &rows)
+    {
+        if (packed.empty())
+            return;
+
+        const int words = packed.words_per_row;
+        const int tail = packed.cols % 64;
+        const uint64_t last_mask = tail == 0 ? ~0ULL : (1ULL << tail) - 1; // Keeps the padding bits 0
+
+        // 1. Horizontal: pixel x takes x - 1 (bit shifted up) and x + 1 (bit shifted down)
+        for (int y = 0; y < packed.rows; y++)
+        {
+            uint64_t *row = packed.row(y);
+            uint64_t carry = 0; // Top bit of the previous word, before it was dilated
+            for (int w = 0; w < words; w++)
+            {
+                const uint64_t v = row[w];
+                const uint64_t next = w + 1 < words ? row[w + 1] : 0;
+                row[w] = v | (v << 1) | carry | (v >> 1) | (next << 63);
+                carry = v >> 63;
+            }
+            row[words - 1] &= last_mask;
+        }
+
+        // 2. Vertical: rows y - 1 and y + 1; the row above is kept before it is overwritten.
+        // Outside the image counts as no edge, like cv::dilate's default border.
+        rows.assign(static_cast<size_t>(words) * 2, 0);
+        uint64_t *above = rows.data();
+        uint64_t *current = rows.data() + words;
+        for (int y = 0; y < packed.rows; y++)
+        {
+            uint64_t *row = packed.row(y);
+            std::copy(row, row + words, current);
+            if (y + 1 < packed.rows)
+            {
+                const uint64_t *below = packed.row(y + 1);
+                for (int w = 0; w < words; w++)
+                    row[w] = current[w] | above[w] | below[w];
+            }
+            else
+            {
+                for (int w = 0; w < words; w++)
+                    row[w] = current[w] | above[w];
+            }
+            std::swap(above, current);
+        }
+    }
+
+    void clear_packed_rect(PackedEdges &packed, const cv::Rect &rect)
+    {
+        // Bits [x0, x1) of every row in the rectangle
+        const int x0 = rect.x;
+        const int x1 = rect.x + rect.width;
+        if (x1 <= x0)
+            return;
+        for (int y = rect.y; y < rect.y + rect.height; y++)
+        {
+            uint64_t *row = packed.row(y);
+            for (int w = x0 / 64; w <= (x1 - 1) / 64; w++)
+            {
+                const int lo = std::max(x0 - w * 64, 0);
+                const int hi = std::min(x1 - w * 64, 64);
+                const uint64_t bits = (hi == 64 ? ~0ULL : (1ULL << hi) - 1) & ~((1ULL << lo) - 1);
+                row[w] &= ~bits;
+            }
+        }
+    }
+
+    void unpack_edges(const PackedEdges &packed, cv::Mat &edges)
+    {
+        edges.create(packed.rows, packed.cols, CV_8UC1);
+        for (int y = 0; y < packed.rows; y++)
+        {
+            const uint64_t *src = packed.row(y);
+            uchar *dst = edges.ptr<uchar>(y);
+            for (int x = 0; x < packed.cols; x++)
+                dst[x] = (src[x / 64] >> (x % 64)) & 1 ? 255 : 0;
+        }
+    }
+
+    double packed_tile_change_ratio(const PackedEdges &edges1, const PackedEdges &edges2, std::vector<int> &tile_counts)
+    {
+        static_assert(64 % CHANGE_TILE_SIZE == 0, "Tiles must not straddle 64-bit words");
+        constexpr int TILES_PER_WORD = 64 / CHANGE_TILE_SIZE;
+        constexpr uint64_t TILE_MASK = (1ULL << CHANGE_TILE_SIZE) - 1;
+
+        if (edges1.empty() || edges2.empty())
+            return 1.0;
+        if (edges1.rows != edges2.rows || edges1.cols != edges2.cols)
+            throw std::invalid_argument("packed_tile_change_ratio: edge maps must have the same size");
+
+        const int rows = edges1.rows;
+        const int cols = edges1.cols;
+        const int tiles_x = (cols + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        const int tiles_y = (rows + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        tile_counts.resize(static_cast<size_t>(edges1.words_per_row) * TILES_PER_WORD);
+
+        int dirty_tiles = 0;
+        for (int ty = 0; ty < tiles_y; ty++)
+        {
+            std::fill(tile_counts.begin(), tile_counts.end(), 0);
+
+            const int y0 = ty * CHANGE_TILE_SIZE;
+            const int tile_h = std::min(CHANGE_TILE_SIZE, rows - y0);
+            for (int y = y0; y < y0 + tile_h; y++)
+            {
+                const uint64_t *a = edges1.row(y);
+                const uint64_t *b = edges2.row(y);
+                for (int w = 0; w < edges1.words_per_row; w++)
+                {
+                    uint64_t d = a[w] ^ b[w];
+                    if (!d)
+                        continue;
+                    for (int k = 0; k < TILES_PER_WORD; k++)
+                        tile_counts[w * TILES_PER_WORD + k] += popcount64((d >> (k * CHANGE_TILE_SIZE)) & TILE_MASK);
+                }
+            }
+
+            for (int tx = 0; tx < tiles_x; tx++)
+            {
+                const int tile_w = std::min(CHANGE_TILE_SIZE, cols - tx * CHANGE_TILE_SIZE);
+                if (is_dirty_tile(tile_counts[tx], tile_w, tile_h))
+                    dirty_tiles++;
+            }
+        }
+
+        return static_cast<double>(dirty_tiles) / (tiles_x * tiles_y);
+    }
+
+} // namespace ai_interview
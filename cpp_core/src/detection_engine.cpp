@@ -0,0 +1,121 @@
+#include "ai_interview/detection_engine.hpp"
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <numeric>
+
+namespace ai_interview
+{
+
+    SlideDetectionEngine::SlideDetectionEngine(int num_threads, double min_scene_duration_sec, double min_area_ratio)
+        : detector_(min_scene_duration_sec, min_area_ratio),
+          pool_(num_threads)
+    {
+        detector_.set_num_threads(1);
+    }
+
+    std::future<VideoResult> SlideDetectionEngine::submit(const std::string &video_path, ResultCallback on_done)
+    {
+        return enqueue(video_path, false, FrameCaptureOptions(), std::move(on_done));
+    }
+
+    std::future<VideoResult> SlideDetectionEngine::submit_with_frames(const std::string &video_path,
+                                                                      const FrameCaptureOptions &options,
+                                                                      ResultCallback on_done)
+    {
+        return enqueue(video_path, true, options, std::move(on_done));
+    }
+
+    std::future<VideoResult> SlideDetectionEngine::enqueue(const std::string &video_path, bool capture_frames,
+                                                           const FrameCaptureOptions &options, ResultCallback on_done)
+    {
+        auto promise = std::make_shared<std::promise<VideoResult>>();
+        std::future<VideoResult> result = promise->get_future();
+
+        pool_.post([this, promise, video_path, capture_frames, options, on_done = std::move(on_done)]()
+                   {
+            VideoResult video;
+            video.video_path = video_path;
+            try
+            {
+                if (capture_frames)
+                {
+                    video.slides = detector_.process_video_with_frames(video_path, options, &video.stats);
+                    video.segments.reserve(video.slides.size());
+                    for (const auto &slide : video.slides)
+                        video.segments.push_back(slide.segment);
+                }
+                else
+                {
+                    video.segments = detector_.process_video(video_path, &video.stats);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                video.error = e.what();
+            }
+            catch (...)
+            {
+                video.error = "unknown error";
+            }
+
+            try
+            {
+                if (on_done)
+                    on_done(video);
+                promise->set_value(std::move(video));
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            } });
+
+        return result;
+    }
+
+    std::vector<VideoResult> SlideDetectionEngine::process_videos(const std::vector<std::string> &video_paths,
+                                                                  ResultCallback on_done)
+    {
+        return run_batch(video_paths, false, FrameCaptureOptions(), on_done);
+    }
+
+    std::vector<VideoResult> SlideDetectionEngine::process_videos_with_frames(const std::vector<std::string> &video_paths,
+                                                                              const FrameCaptureOptions &options,
+                                                                              ResultCallback on_done)
+    {
+        return run_batch(video_paths, true, options, on_done);
+    }
+
+    std::vector<VideoResult> SlideDetectionEngine::run_batch(const std::vector<std::string> &video_paths,
+                                                             bool capture_frames, const FrameCaptureOptions &options,
+                                                             const ResultCallback &on_done)
+    {
+        // Longest first (file size as the proxy): the classic greedy order for a short makespan
+        std::vector<uintmax_t> sizes(video_paths.size(), 0);
+        for (size_t i = 0; i < video_paths.size(); i++)
+        {
+            std::error_code ec;
+            const uintmax_t size = std::filesystem::file_size(video_paths[i], ec);
+            sizes[i] = ec ? 0 : size;
+        }
+        std::vector<size_t> order(video_paths.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return sizes[a] > sizes[b]; });
+
+        std::vector<std::future<VideoResult>> futures(video_paths.size());
+        for (size_t i : order)
+            futures[i] = enqueue(video_paths[i], capture_frames, options, on_done);
+
+        // Wait for all of them before get(), so an exception from on_done doesn't leave scans running
+        for (auto &future : futures)
+            future.wait();
+
+        std::vector<VideoResult> results;
+        results.reserve(futures.size());
+        for (auto &future : futures)
+            results.push_back(future.get());
+        return results;
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,99 @@
+#include "ai_interview/noise_floor.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ai_interview
+{
+
+    StreamingQuantile::StreamingQuantile(double quantile)
+        : quantile_(quantile),
+          desired_{0.0, 2.0 * quantile, 4.0 * quantile, 2.0 + 2.0 * quantile, 4.0},
+          increments_{0.0, quantile / 2.0, quantile, (1.0 + quantile) / 2.0, 1.0}
+    {
+        for (int i = 0; i < 5; i++)
+            positions_[i] = i;
+    }
+
+    void StreamingQuantile::add(double x)
+    {
+        // First five samples: kept sorted, they become the initial markers
+        if (count_ < 5)
+        {
+            auto end = heights_.begin() + static_cast<std::ptrdiff_t>(count_);
+            heights_[count_++] = x;
+            std::inplace_merge(heights_.begin(), end, end + 1);
+            return;
+        }
+        count_++;
+
+        // Cell of the new sample; the extreme markers follow the minimum / maximum
+        int cell = 0;
+        if (x < heights_[0])
+        {
+            heights_[0] = x;
+        }
+        else if (x >= heights_[4])
+        {
+            heights_[4] = x;
+            cell = 3;
+        }
+        else
+        {
+            while (cell < 3 && x >= heights_[cell + 1])
+                cell++;
+        }
+
+        for (int i = cell + 1; i < 5; i++)
+            positions_[i] += 1.0;
+        for (int i = 0; i < 5; i++)
+            desired_[i] += increments_[i];
+
+        // Move the middle markers one step towards their desired position
+        for (int i = 1; i < 4; i++)
+        {
+            const double offset = desired_[i] - positions_[i];
+            if ((offset >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+                (offset <= -1.0 && positions_[i - 1] - positions_[i] < -1.0))
+            {
+                const int d = offset > 0.0 ? 1 : -1;
+
+                // Piecewise-parabolic prediction; linear if it would break the marker order
+                const double parabolic =
+                    heights_[i] + d / (positions_[i + 1] - positions_[i - 1]) *
+                                      ((positions_[i] - positions_[i - 1] + d) * (heights_[i + 1] - heights_[i]) /
+                                           (positions_[i + 1] - positions_[i]) +
+                                       (positions_[i + 1] - positions_[i] - d) * (heights_[i] - heights_[i - 1]) /
+                                           (positions_[i] - positions_[i - 1]));
+                if (heights_[i - 1] < parabolic && parabolic < heights_[i + 1])
+                    heights_[i] = parabolic;
+                else
+                    heights_[i] += d * (heights_[i + d] - heights_[i]) / (positions_[i + d] - positions_[i]);
+                positions_[i] += d;
+            }
+        }
+    }
+
+    double StreamingQuantile::value() const
+    {
+        if (count_ == 0)
+            return 0.0;
+        if (count_ >= 5)
+            return heights_[2];
+
+        // Few samples: nearest rank of the sorted ones
+        const size_t rank = static_cast<size_t>(std::lround(quantile_ * static_cast<double>(count_ - 1)));
+        return heights_[rank];
+    }
+
+    void NoiseFloor::add(double score)
+    {
+        median_.add(score);
+        deviation_.add(std::fabs(score - median_.value()));
+    }
+
+    double NoiseFloor::threshold(double sensitivity) const
+    {
+        return std::clamp(median() + sensitivity * MAD_TO_SIGMA * mad(), ADAPTIVE_MIN_RATIO, ADAPTIVE_MAX_RATIO);
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,349 @@
+#include "ai_interview/result_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+// On-disk cache of detection results.
+//
+// File layout (native byte order, the cache is local to the machine):
+//   "AISC" | u32 version | u64 content | u64 params | u32 count
+//   count x { i32 frame_index | f64 timestamp_sec | f64 change_ratio | i32 slide_id | u8 is_revisit
+//             | u8 is_build_up | u32 changed count | changed count x { f64 x, y, width, height }
+//             | image | u32 region count | region count x { i32 x, y, width, height | image } }
+// where image is u8 kind + nothing (kind 0), i32 rows, i32 cols, i32 type + pixels (kind 1, raw Mat)
+// or u32 size + bytes (kind 2, encoded).
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        constexpr char CACHE_MAGIC[4] = {'A', 'I', 'S', 'C'};
+
+        enum ImageKind : uint8_t
+        {
+            NoImage = 0,
+            RawImage = 1,
+            EncodedImage = 2
+        };
+
+        constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+
+        inline uint64_t rotl(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+
+        template <typename T>
+        void put(std::ostream &out, const T &value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool get(std::istream &in, T &value)
+        {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+
+        // Raw or encoded image (one of them is empty)
+        void put_image(std::ostream &out, const cv::Mat &image, const std::vector<uchar> &encoded)
+        {
+            if (!encoded.empty())
+            {
+                put(out, static_cast<uint8_t>(EncodedImage));
+                put(out, static_cast<uint32_t>(encoded.size()));
+                out.write(reinterpret_cast<const char *>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+            }
+            else if (!image.empty())
+            {
+                const cv::Mat pixels = image.isContinuous() ? image : image.clone();
+                put(out, static_cast<uint8_t>(RawImage));
+                put(out, pixels.rows);
+                put(out, pixels.cols);
+                put(out, pixels.type());
+                out.write(reinterpret_cast<const char *>(pixels.data),
+                          static_cast<std::streamsize>(pixels.total() * pixels.elemSize()));
+            }
+            else
+            {
+                put(out, static_cast<uint8_t>(NoImage));
+            }
+        }
+
+        // Smallest stored sizes, to reject counts a truncated or corrupt file can't hold
+        constexpr uint64_t MIN_SLIDE_BYTES = 4 + 8 + 8 + 4 + 1 + 1 + 4 + 1 + 4;
+        constexpr uint64_t CHANGED_RECT_BYTES = 4 * sizeof(double);
+        constexpr uint64_t MIN_TEXT_REGION_BYTES = 4 * sizeof(int32_t) + 1;
+
+        // Bytes left between the read position and `end` (the file size)
+        uint64_t remaining(std::istream &in, uint64_t end)
+        {
+            const std::streamoff pos = in.tellg();
+            if (pos < 0 || static_cast<uint64_t>(pos) > end)
+                return 0;
+            return end - static_cast<uint64_t>(pos);
+        }
+
+        bool get_image(std::istream &in, uint64_t end, cv::Mat &image, std::vector<uchar> &encoded)
+        {
+            uint8_t kind = NoImage;
+            if (!get(in, kind))
+                return false;
+
+            if (kind == RawImage)
+            {
+                int rows = 0, cols = 0, type = 0;
+                if (!get(in, rows) || !get(in, cols) || !get(in, type) || rows < 0 || cols < 0)
+                    return false;
+                // Only plain Mat types (no flags, a known depth, the channel counts store_cached_result writes)
+                if (type < 0 || type != CV_MAT_TYPE(type) || CV_MAT_DEPTH(type) > CV_64F ||
+                    CV_MAT_CN(type) > 4)
+                    return false;
+                const uint64_t bytes = static_cast<uint64_t>(rows) * static_cast<uint64_t>(cols) * CV_ELEM_SIZE(type);
+                if (bytes > remaining(in, end))
+                    return false;
+                image.create(rows, cols, type);
+                return static_cast<bool>(in.read(reinterpret_cast<char *>(image.data),
+                                                 static_cast<std::streamsize>(bytes)));
+            }
+            if (kind == EncodedImage)
+            {
+                uint32_t size = 0;
+                if (!get(in, size) || size > remaining(in, end))
+                    return false;
+                encoded.resize(size);
+                return static_cast<bool>(in.read(reinterpret_cast<char *>(encoded.data()), size));
+            }
+            return kind == NoImage;
+        }
+    } // namespace
+
+    uint64_t hash_bytes(const void *data, size_t size, uint64_t seed)
+    {
+        const auto *p = static_cast<const unsigned char *>(data);
+        uint64_t h = seed ^ (static_cast<uint64_t>(size) * PRIME1);
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, p + i, sizeof(w));
+            h ^= rotl(w * PRIME2, 31) * PRIME1;
+            h = rotl(h, 27) * PRIME1 + PRIME3;
+        }
+        if (i < size)
+        {
+            uint64_t w = 0;
+            std::memcpy(&w, p + i, size - i);
+            h ^= rotl(w * PRIME2, 31) * PRIME1;
+            h = rotl(h, 27) * PRIME1 + PRIME3;
+        }
+
+        // Final avalanche
+        h ^= h >> 33;
+        h *= PRIME2;
+        h ^= h >> 29;
+        h *= PRIME3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    bool fingerprint_video_file(const std::string &path, uint64_t &fingerprint)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+
+        const uint64_t size = static_cast<uint64_t>(in.tellg());
+        uint64_t h = hash_bytes(&size, sizeof(size));
+
+        std::vector<char> block(FINGERPRINT_BLOCK_SIZE);
+        const uint64_t last_offset = size > FINGERPRINT_BLOCK_SIZE ? size - FINGERPRINT_BLOCK_SIZE : 0;
+        for (int i = 0; i < FINGERPRINT_BLOCKS; i++)
+        {
+            // Evenly spread from the start to the end of the file (small files: one block is everything)
+            const uint64_t offset = last_offset * i / (FINGERPRINT_BLOCKS - 1);
+            in.seekg(static_cast<std::streamoff>(offset));
+            in.read(block.data(), static_cast<std::streamsize>(block.size()));
+            h = hash_bytes(block.data(), static_cast<size_t>(in.gcount()), h);
+            in.clear();
+            if (last_offset == 0)
+                break;
+        }
+
+        fingerprint = h;
+        return true;
+    }
+
+    bool fingerprint_video_buffer(const uint8_t *data, size_t size, uint64_t &fingerprint)
+    {
+        if (!data)
+            return false;
+
+        const uint64_t total = size;
+        uint64_t h = hash_bytes(&total, sizeof(total));
+
+        // Same blocks as fingerprint_video_file, so a buffer and its file share cache entries
+        const uint64_t last_offset = total > FINGERPRINT_BLOCK_SIZE ? total - FINGERPRINT_BLOCK_SIZE : 0;
+        for (int i = 0; i < FINGERPRINT_BLOCKS; i++)
+        {
+            const uint64_t offset = last_offset * i / (FINGERPRINT_BLOCKS - 1);
+            const size_t length = static_cast<size_t>(std::min<uint64_t>(FINGERPRINT_BLOCK_SIZE, total - offset));
+            h = hash_bytes(data + offset, length, h);
+            if (last_offset == 0)
+                break;
+        }
+
+        fingerprint = h;
+        return true;
+    }
+
+    std::string result_cache_path(const std::string &directory, const ResultCacheKey &key)
+    {
+        char name[48];
+        std::snprintf(name, sizeof(name), "%016llx-%016llx.slides",
+                      static_cast<unsigned long long>(key.content), static_cast<unsigned long long>(key.params));
+        return (std::filesystem::path(directory) / name).string();
+    }
+
+    bool load_cached_result(const std::string &path, const ResultCacheKey &key, std::vector<CapturedSlide> &slides)
+    {
+        // A corrupt or truncated file is a cache miss, never an error
+        try
+        {
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in)
+                return false;
+            const std::streamoff file_size = in.tellg();
+            if (file_size < 0)
+                return false;
+            const uint64_t end = static_cast<uint64_t>(file_size);
+            in.seekg(0);
+
+            char magic[4];
+            uint32_t version = 0;
+            ResultCacheKey stored;
+            uint32_t count = 0;
+            if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+                !get(in, version) || version != RESULT_CACHE_VERSION ||
+                !get(in, stored.content) || !get(in, stored.params) ||
+                stored.content != key.content || stored.params != key.params || !get(in, count) ||
+                count > remaining(in, end) / MIN_SLIDE_BYTES)
+                return false;
+
+            std::vector<CapturedSlide> result(count);
+            for (auto &slide : result)
+            {
+                uint8_t is_revisit = 0, is_build_up = 0;
+                uint32_t num_changed = 0, num_regions = 0;
+                if (!get(in, slide.segment.frame_index) || !get(in, slide.segment.timestamp_sec) ||
+                    !get(in, slide.segment.change_ratio) || !get(in, slide.segment.slide_id) ||
+                    !get(in, is_revisit) || !get(in, is_build_up) || !get(in, num_changed) ||
+                    num_changed > remaining(in, end) / CHANGED_RECT_BYTES)
+                    return false;
+                slide.segment.is_revisit = is_revisit != 0;
+                slide.segment.is_build_up = is_build_up != 0;
+
+                slide.segment.changed_regions.resize(num_changed);
+                for (auto &rect : slide.segment.changed_regions)
+                {
+                    if (!get(in, rect.x) || !get(in, rect.y) || !get(in, rect.width) || !get(in, rect.height))
+                        return false;
+                }
+                if (!get_image(in, end, slide.frame, slide.encoded) || !get(in, num_regions) ||
+                    num_regions > remaining(in, end) / MIN_TEXT_REGION_BYTES)
+                    return false;
+
+                slide.text_regions.resize(num_regions);
+                for (auto &text : slide.text_regions)
+                {
+                    if (!get(in, text.rect.x) || !get(in, text.rect.y) || !get(in, text.rect.width) ||
+                        !get(in, text.rect.height) || !get_image(in, end, text.image, text.encoded))
+                        return false;
+                }
+            }
+
+            slides = std::move(result);
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+    }
+
+    bool store_cached_result(const std::string &path, const ResultCacheKey &key, const std::vector<CapturedSlide> &slides)
+    {
+        std::error_code ec;
+        const std::filesystem::path target(path);
+        if (target.has_parent_path())
+            std::filesystem::create_directories(target.parent_path(), ec);
+
+        // Unique temporary name: several scans of the same video may finish at the same time
+        const std::string tmp = path + ".tmp" +
+                                std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "-" +
+                                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            put(out, RESULT_CACHE_VERSION);
+            put(out, key.content);
+            put(out, key.params);
+            put(out, static_cast<uint32_t>(slides.size()));
+
+            for (const auto &slide : slides)
+            {
+                put(out, slide.segment.frame_index);
+                put(out, slide.segment.timestamp_sec);
+                put(out, slide.segment.change_ratio);
+                put(out, static_cast<int32_t>(slide.segment.slide_id));
+                put(out, static_cast<uint8_t>(slide.segment.is_revisit));
+                put(out, static_cast<uint8_t>(slide.segment.is_build_up));
+                put(out, static_cast<uint32_t>(slide.segment.changed_regions.size()));
+                for (const auto &rect : slide.segment.changed_regions)
+                {
+                    put(out, rect.x);
+                    put(out, rect.y);
+                    put(out, rect.width);
+                    put(out, rect.height);
+                }
+                put_image(out, slide.frame, slide.encoded);
+
+                put(out, static_cast<uint32_t>(slide.text_regions.size()));
+                for (const auto &text : slide.text_regions)
+                {
+                    put(out, text.rect.x);
+                    put(out, text.rect.y);
+                    put(out, text.rect.width);
+                    put(out, text.rect.height);
+                    put_image(out, text.image, text.encoded);
+                }
+            }
+
+            if (!out.flush())
+            {
+                out.close();
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmp, target, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace ai_interview
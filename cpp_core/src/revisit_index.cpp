@@ -0,0 +1,66 @@
+#include "ai_interview/revisit_index.hpp"
+#include "ai_interview/signal_index.hpp"
+#include "ai_interview/slide_detector.hpp"
+
+namespace ai_interview
+{
+
+    RevisitIndex::RevisitIndex(int capacity, double max_change_ratio)
+        : capacity_(capacity),
+          max_change_ratio_(max_change_ratio)
+    {
+    }
+
+    void RevisitIndex::classify(SlideSegment &segment, PackedEdges occupancy)
+    {
+        segment.is_revisit = false;
+        if (!enabled() || occupancy.empty())
+        {
+            segment.slide_id = next_id_++;
+            return;
+        }
+
+        // A build-up adds to the previous slide: new text, so never the text of an earlier slide
+        if (segment.is_build_up)
+        {
+            remember(segment, std::move(occupancy));
+            return;
+        }
+
+        // Closest remembered slide (a handful of 2 KB XOR + popcount passes).
+        // The most recent entry is the slide this frame was just found to differ from: the coarse
+        // occupancy maps may still look alike (same template, small edits), so it is skipped.
+        auto best = entries_.end();
+        double best_ratio = max_change_ratio_;
+        for (auto it = entries_.empty() ? entries_.end() : std::next(entries_.begin()); it != entries_.end(); ++it)
+        {
+            if (it->occupancy.rows != occupancy.rows || it->occupancy.cols != occupancy.cols)
+                continue;
+            double ratio = occupancy_change_ratio(it->occupancy, occupancy);
+            if (ratio <= best_ratio)
+            {
+                best = it;
+                best_ratio = ratio;
+            }
+        }
+
+        if (best != entries_.end())
+        {
+            segment.slide_id = best->slide_id;
+            segment.is_revisit = true;
+            entries_.splice(entries_.begin(), entries_, best); // Now the most recent
+            return;
+        }
+
+        remember(segment, std::move(occupancy));
+    }
+
+    void RevisitIndex::remember(SlideSegment &segment, PackedEdges occupancy)
+    {
+        segment.slide_id = next_id_++;
+        entries_.push_front(Entry{segment.slide_id, std::move(occupancy)});
+        if (static_cast<int>(entries_.size()) > capacity_)
+            entries_.pop_back();
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,89 @@
+#include "ai_interview/scan_stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace ai_interview
+{
+
+    const char *scan_stage_name(ScanStage stage)
+    {
+        switch (stage)
+        {
+        case ScanStage::Decode:
+            return "decode";
+        case ScanStage::Convert:
+            return "convert";
+        case ScanStage::Thumbnail:
+            return "thumbnail";
+        case ScanStage::Resize:
+            return "resize";
+        case ScanStage::EdgeMap:
+            return "edge_map";
+        case ScanStage::ChangeMetric:
+            return "change_metric";
+        default:
+            return "unknown";
+        }
+    }
+
+    void StageStats::add(double seconds)
+    {
+        count++;
+        total_sec += seconds;
+        max_sec = std::max(max_sec, seconds);
+
+        // Smallest i with seconds < 2^i us
+        const double micros = seconds * 1e6;
+        int bucket = 0;
+        while (bucket < STAGE_HISTOGRAM_BUCKETS - 1 && micros >= static_cast<double>(1ULL << bucket))
+            bucket++;
+        histogram[bucket]++;
+    }
+
+    void StageStats::merge(const StageStats &other)
+    {
+        count += other.count;
+        total_sec += other.total_sec;
+        max_sec = std::max(max_sec, other.max_sec);
+        for (int i = 0; i < STAGE_HISTOGRAM_BUCKETS; i++)
+            histogram[i] += other.histogram[i];
+    }
+
+    double StageStats::bucket_upper_bound_sec(int bucket)
+    {
+        if (bucket >= STAGE_HISTOGRAM_BUCKETS - 1)
+            return std::numeric_limits<double>::infinity();
+        return std::ldexp(1e-6, bucket);
+    }
+
+    void ScanStats::merge(const ScanStats &other)
+    {
+        frames_decoded += other.frames_decoded;
+        frames_skipped += other.frames_skipped;
+        frames_analyzed += other.frames_analyzed;
+        frames_static += other.frames_static;
+        for (int i = 0; i < NUM_SCAN_STAGES; i++)
+            stages[i].merge(other.stages[i]);
+    }
+
+    uint64_t current_rss_bytes()
+    {
+#if defined(__linux__)
+        // Second field: resident pages
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0, resident = 0;
+        if (!(statm >> size >> resident))
+            return 0;
+        const long page_size = sysconf(_SC_PAGESIZE);
+        return page_size > 0 ? resident * static_cast<uint64_t>(page_size) : 0;
+#else
+        return 0;
+#endif
+    }
+
+} // namespace ai_interview
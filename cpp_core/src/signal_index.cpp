@@ -0,0 +1,195 @@
+#include "ai_interview/signal_index.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        constexpr char INDEX_MAGIC[4] = {'A', 'I', 'S', 'I'};
+
+        template <typename T>
+        void put(std::ostream &out, const T &value)
+        {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool get(std::istream &in, T &value)
+        {
+            return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+
+        inline int popcount64(uint64_t v)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(v);
+#else
+            v = v - ((v >> 1) & 0x5555555555555555ULL);
+            v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+            v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<int>((v * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+    } // namespace
+
+    static_assert(sizeof(SignalRecord) == 32, "SignalRecord is part of the file format");
+
+    void save_signal_index(const std::string &path, const SignalIndex &index)
+    {
+        if (index.occupancy.size() != index.records.size() * index.signature_words())
+            throw std::invalid_argument("save_signal_index: occupancy size doesn't match the records");
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("Could not write signal index: " + path);
+
+        out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        put(out, SIGNAL_INDEX_VERSION);
+        put(out, index.fps);
+        put(out, index.min_scene_duration);
+        put(out, index.min_area_ratio);
+        put(out, static_cast<int32_t>(index.block_rows));
+        put(out, static_cast<int32_t>(index.block_cols));
+        put(out, static_cast<int32_t>(index.words_per_row));
+        put(out, static_cast<uint32_t>(index.records.size()));
+        out.write(reinterpret_cast<const char *>(index.records.data()),
+                  static_cast<std::streamsize>(index.records.size() * sizeof(SignalRecord)));
+        out.write(reinterpret_cast<const char *>(index.occupancy.data()),
+                  static_cast<std::streamsize>(index.occupancy.size() * sizeof(uint64_t)));
+
+        if (!out.flush())
+            throw std::runtime_error("Could not write signal index: " + path);
+    }
+
+    SignalIndex load_signal_index(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("Could not open signal index: " + path);
+
+        char magic[4];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0)
+            throw std::runtime_error("Not a signal index: " + path);
+
+        uint32_t version = 0;
+        if (!get(in, version) || version != SIGNAL_INDEX_VERSION)
+            throw std::runtime_error("Unsupported signal index version: " + path);
+
+        SignalIndex index;
+        int32_t block_rows = 0, block_cols = 0, words_per_row = 0;
+        uint32_t count = 0;
+        if (!get(in, index.fps) || !get(in, index.min_scene_duration) || !get(in, index.min_area_ratio) ||
+            !get(in, block_rows) || !get(in, block_cols) || !get(in, words_per_row) || !get(in, count) ||
+            block_rows < 0 || block_cols < 0 || words_per_row < 0)
+            throw std::runtime_error("Truncated signal index: " + path);
+
+        index.block_rows = block_rows;
+        index.block_cols = block_cols;
+        index.words_per_row = words_per_row;
+        index.records.resize(count);
+        index.occupancy.resize(count * index.signature_words());
+        if (!in.read(reinterpret_cast<char *>(index.records.data()),
+                     static_cast<std::streamsize>(index.records.size() * sizeof(SignalRecord))) ||
+            !in.read(reinterpret_cast<char *>(index.occupancy.data()),
+                     static_cast<std::streamsize>(index.occupancy.size() * sizeof(uint64_t))))
+            throw std::runtime_error("Truncated signal index: " + path);
+
+        return index;
+    }
+
+    void compute_occupancy_map(const cv::Mat &edges, cv::Mat &blocks, PackedEdges &occupancy)
+    {
+        // INTER_AREA mean of the 0/255 map per block, rounded to 8 bits (hence -0.5)
+        const int blocks_x = (edges.cols + SIGNAL_BLOCK_SIZE - 1) / SIGNAL_BLOCK_SIZE;
+        const int blocks_y = (edges.rows + SIGNAL_BLOCK_SIZE - 1) / SIGNAL_BLOCK_SIZE;
+        cv::resize(edges, blocks, cv::Size(blocks_x, blocks_y), 0, 0, cv::INTER_AREA);
+        cv::threshold(blocks, blocks,
+                      SIGNAL_BLOCK_MIN_PIXELS * 255.0 / (SIGNAL_BLOCK_SIZE * SIGNAL_BLOCK_SIZE) - 0.5, 255,
+                      cv::THRESH_BINARY);
+        pack_edges(blocks, occupancy);
+    }
+
+    double occupancy_change_ratio(const uint64_t *a, const uint64_t *b, int block_rows, int block_cols,
+                                  int words_per_row)
+    {
+        const int tiles_x = (block_cols + 1) / 2;
+        const int tiles_y = (block_rows + 1) / 2;
+        if (tiles_x == 0 || tiles_y == 0)
+            return 1.0;
+
+        const size_t row_words = words_per_row;
+        int dirty_tiles = 0;
+        for (int ty = 0; ty < tiles_y; ty++)
+        {
+            const int y0 = 2 * ty;
+            const bool has_second_row = y0 + 1 < block_rows; // Odd block_rows: last tile row is one block high
+            const uint64_t *a0 = a + y0 * row_words;
+            const uint64_t *b0 = b + y0 * row_words;
+
+            for (size_t w = 0; w < row_words; w++)
+            {
+                uint64_t d = a0[w] ^ b0[w];
+                if (has_second_row)
+                    d |= a0[row_words + w] ^ b0[row_words + w];
+                // Tile k of the word covers bits 2k and 2k+1 (64 is even, so tiles don't straddle words)
+                dirty_tiles += popcount64((d | (d >> 1)) & 0x5555555555555555ULL);
+            }
+        }
+
+        return static_cast<double>(dirty_tiles) / (tiles_x * tiles_y);
+    }
+
+    double occupancy_change_ratio(const PackedEdges &a, const PackedEdges &b)
+    {
+        if (a.empty() || b.empty())
+            return 1.0;
+        if (a.rows != b.rows || a.cols != b.cols)
+            throw std::invalid_argument("occupancy_change_ratio: maps must have the same size");
+        return occupancy_change_ratio(a.bits.data(), b.bits.data(), a.rows, a.cols, a.words_per_row);
+    }
+
+    double estimate_change_ratio(const SignalIndex &index, size_t a, size_t b)
+    {
+        return occupancy_change_ratio(index.signature(a), index.signature(b), index.block_rows, index.block_cols,
+                                      index.words_per_row);
+    }
+
+    std::vector<SlideSegment> select_segments(const SignalIndex &index, double min_scene_duration,
+                                              double min_area_ratio)
+    {
+        std::vector<SlideSegment> segments;
+        size_t reference = 0;
+        bool has_reference = false;
+        double last_slide_time = -min_scene_duration;
+
+        for (size_t i = 0; i < index.records.size(); i++)
+        {
+            const SignalRecord &record = index.records[i];
+
+            double score = 1.0; // The first frame is always a slide
+            if (has_reference)
+            {
+                if (record.timestamp_sec - last_slide_time < min_scene_duration)
+                    continue;
+
+                score = record.reference_frame == index.records[reference].frame_index
+                            ? record.change_score
+                            : estimate_change_ratio(index, reference, i);
+                if (score <= min_area_ratio)
+                    continue;
+            }
+
+            segments.push_back(SlideSegment{record.frame_index, record.timestamp_sec, score});
+            segments.back().slide_id = static_cast<int>(segments.size()) - 1; // No revisit tracking here
+            reference = i;
+            has_reference = true;
+            last_slide_time = record.timestamp_sec;
+        }
+
+        return segments;
+    }
+
+} // namespace ai_interview
@@ -1,6 +1,14 @@
 #include "ai_interview/slide_detector.hpp"
+#include "ai_interview/result_cache.hpp"
+#include "ai_interview/signal_index.hpp"
+#include <opencv2/videoio/registry.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
+#include <thread>
 
 namespace ai_interview
 {
@@ -8,54 +16,236 @@ namespace ai_interview
     SlideDetector::SlideDetector(double min_scene_duration_sec, double min_area_ratio)
         : min_duration_(min_scene_duration_sec),
           min_area_ratio_(min_area_ratio),
-          frame_width_(0),
-          frame_height_(0)
+          frame_stride_(1),
+          target_analysis_fps_(0.0),
+          coarse_threshold_(0.0),
+          num_threads_(DEFAULT_NUM_THREADS),
+          num_chunks_(0),
+          change_metric_(ChangeMetric::Contours),
+          compute_backend_(ComputeBackend::CPU),
+          decode_acceleration_(DecodeAcceleration::None),
+          decode_device_(-1),
+          reduced_decode_(false),
+          cache_dir_(),
+          memory_budget_(0),
+          spill_dir_(),
+          revisit_history_(0),
+          adaptive_sensitivity_(0.0),
+          region_(),
+          auto_exclude_sec_(0.0),
+          dilation_kernel_(cv::getStructuringElement(cv::MORPH_RECT,
+                                                     cv::Size(DILATION_KERNEL_SIZE, DILATION_KERNEL_SIZE))),
+          join_kernel_(cv::getStructuringElement(cv::MORPH_RECT,
+                                                 cv::Size(CHANGE_REGION_JOIN_SIZE, CHANGE_REGION_JOIN_SIZE)))
     {
     }
 
-    cv::Mat SlideDetector::compute_edge_map(const cv::Mat &frame)
+    void SlideDetector::set_frame_stride(int stride)
     {
-        cv::Mat gray, blurred, edges, dilated;
+        if (stride < 1)
+            throw std::invalid_argument("Frame stride must be >= 1");
+        frame_stride_ = stride;
+    }
+
+    void SlideDetector::set_target_analysis_fps(double fps)
+    {
+        if (fps < 0.0)
+            throw std::invalid_argument("Target analysis FPS must be >= 0");
+        target_analysis_fps_ = fps;
+    }
+
+    void SlideDetector::set_coarse_threshold(double threshold)
+    {
+        if (threshold < 0.0)
+            throw std::invalid_argument("Coarse threshold must be >= 0");
+        coarse_threshold_ = threshold;
+    }
+
+    void SlideDetector::set_num_threads(int num_threads)
+    {
+        if (num_threads < 0)
+            throw std::invalid_argument("Number of threads must be >= 0");
+        num_threads_ = num_threads;
+    }
+
+    void SlideDetector::set_num_chunks(int num_chunks)
+    {
+        if (num_chunks < 0)
+            throw std::invalid_argument("Number of chunks must be >= 0");
+        num_chunks_ = num_chunks;
+    }
+
+    void SlideDetector::set_decode_acceleration(DecodeAcceleration acceleration, int device)
+    {
+        if (device < -1)
+            throw std::invalid_argument("Decode device must be >= -1");
+        decode_acceleration_ = acceleration;
+        decode_device_ = device;
+    }
+
+    void SlideDetector::set_revisit_history(int num_slides)
+    {
+        if (num_slides < 0)
+            throw std::invalid_argument("Revisit history must be >= 0");
+        revisit_history_ = num_slides;
+    }
+
+    void SlideDetector::set_adaptive_threshold(double sensitivity)
+    {
+        if (sensitivity < 0.0)
+            throw std::invalid_argument("Adaptive threshold sensitivity must be >= 0");
+        adaptive_sensitivity_ = sensitivity;
+    }
+
+    DecodeInfo SlideDetector::open_capture(cv::VideoCapture &cap, const VideoSource &video) const
+    {
+        DecodeInfo info;
+        if (decode_acceleration_ != DecodeAcceleration::None)
+        {
+            const std::vector<int> params = {
+                cv::CAP_PROP_HW_ACCELERATION, static_cast<int>(decode_acceleration_),
+                cv::CAP_PROP_HW_DEVICE, decode_device_};
+            if (!video.open(cap, params))
+                info.fallback = true;
+        }
+
+        if (!cap.isOpened() && !video.open(cap))
+        {
+            throw std::runtime_error("Could not open video: " + video.description());
+        }
+
+        // The backend reports what it really uses (NONE if it silently decoded in software)
+        info.backend = cap.getBackendName();
+        info.acceleration = static_cast<DecodeAcceleration>(static_cast<int>(cap.get(cv::CAP_PROP_HW_ACCELERATION)));
+        if (info.acceleration != DecodeAcceleration::None)
+            info.device = static_cast<int>(cap.get(cv::CAP_PROP_HW_DEVICE));
+        return info;
+    }
+
+    bool SlideDetector::open_reduced_capture(cv::VideoCapture &cap, const VideoSource &video) const
+    {
+        // GStreamer reads files only (a stream source has no path unless it sits in an in-memory file)
+        const std::string path = video.file_path();
+        if (path.empty() || !cv::videoio_registry::hasBackend(cv::CAP_GSTREAMER))
+            return false;
+
+        const int width = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH));
+        const int height = static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+        if (width <= 0 || height <= 0)
+            return false;
+
+        // Same output size as the cv::resize in analyze_frame, so nothing is resized there
+        int out_width = width;
+        int out_height = height;
+        if (width > DEFAULT_RESIZE_WIDTH)
+        {
+            float scale = static_cast<float>(DEFAULT_RESIZE_WIDTH) / width;
+            out_width = DEFAULT_RESIZE_WIDTH;
+            out_height = cvRound(height * scale);
+        }
+
+        // GRAY8 first: converting I420/NV12 to it is just taking the Y plane, then only one plane is scaled
+        const std::string pipeline = "filesrc location=\"" + path + "\" ! decodebin ! videoconvert ! "
+                                     "video/x-raw,format=GRAY8 ! videoscale ! video/x-raw,width=" +
+                                     std::to_string(out_width) + ",height=" + std::to_string(out_height) +
+                                     " ! appsink sync=false";
+
+        cap.release();
+        bool opened = false;
+        if (decode_acceleration_ != DecodeAcceleration::None)
+        {
+            const std::vector<int> params = {
+                cv::CAP_PROP_HW_ACCELERATION, static_cast<int>(decode_acceleration_),
+                cv::CAP_PROP_HW_DEVICE, decode_device_};
+            opened = cap.open(pipeline, cv::CAP_GSTREAMER, params);
+        }
+        if (!opened)
+            opened = cap.open(pipeline, cv::CAP_GSTREAMER);
+
+        if (!opened)
+        {
+            open_capture(cap, video);
+            return false;
+        }
+        return true;
+    }
+
+    DecodeInfo SlideDetector::get_decode_info(const VideoSource &video) const
+    {
+        cv::VideoCapture cap;
+        return open_capture(cap, video);
+    }
+
+    int SlideDetector::resolved_num_threads() const
+    {
+        if (num_threads_ > 0)
+            return num_threads_;
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    int SlideDetector::effective_stride(double video_fps) const
+    {
+        if (target_analysis_fps_ > 0.0 && video_fps > 0.0)
+            return std::max(1, static_cast<int>(std::lround(video_fps / target_analysis_fps_)));
+        return frame_stride_;
+    }
+
+    void SlideDetector::compute_edge_map(const cv::Mat &frame, Workspace &ws, cv::Mat &edges) const
+    {
+        detect_edges(frame, ws);
+
+        // 4. Dilation.
+        // Make lines thicker. This is needed so that small text shake
+        // (by 1-2 pixels) doesn't produce huge difference when subtracting.
+        // The kernel is built once in the constructor.
+        cv::dilate(ws.edges, edges, dilation_kernel_);
+    }
+
+    void SlideDetector::detect_edges(const cv::Mat &frame, Workspace &ws) const
+    {
+        // All intermediate images live in the workspace: after the first frame they are reused
 
         // 1. Convert to grayscale (color is not important for slide structure)
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        const cv::Mat *gray = &frame;
+        if (frame.channels() != 1)
+        {
+            cv::cvtColor(frame, ws.gray, cv::COLOR_BGR2GRAY);
+            gray = &ws.gray;
+        }
 
         // 2. Blur noise (Gaussian Blur).
         // This is critical so that video compression artifacts are not counted as "edges".
-        cv::GaussianBlur(gray, blurred, cv::Size(GAUSSIAN_BLUR_SIZE, GAUSSIAN_BLUR_SIZE), 0);
+        cv::GaussianBlur(*gray, ws.blurred, cv::Size(GAUSSIAN_BLUR_SIZE, GAUSSIAN_BLUR_SIZE), 0);
 
         // 3. Edge detection (Canny).
         // Leaves only sharp transitions (text, image frames).
         // The speaker's face has smooth transitions and will almost disappear.
-        cv::Canny(blurred, edges, CANNY_THRESHOLD_LOW, CANNY_THRESHOLD_HIGH);
-
-        // 4. Dilation.
-        // Make lines thicker. This is needed so that small text shake
-        // (by 1-2 pixels) doesn't produce huge difference when subtracting.
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT,
-                                                   cv::Size(DILATION_KERNEL_SIZE, DILATION_KERNEL_SIZE));
-        cv::dilate(edges, dilated, kernel);
-
-        return dilated;
+        cv::Canny(ws.blurred, ws.edges, CANNY_THRESHOLD_LOW, CANNY_THRESHOLD_HIGH);
     }
 
-    double SlideDetector::calculate_change_metric(const cv::Mat &edges1, const cv::Mat &edges2)
+    double SlideDetector::calculate_change_metric(const cv::Mat &edges1, const cv::Mat &edges2, Workspace &ws) const
     {
         if (edges1.empty() || edges2.empty())
             return 1.0;
 
-        cv::Mat diff;
+        // Fused engine: one pass, no diff image, no contours
+        if (change_metric_ == ChangeMetric::Tiles)
+            return tile_change_ratio(edges1, edges2, ws.tile_counts);
+
         // Calculate absolute difference between edge maps
-        cv::absdiff(edges1, edges2, diff);
+        cv::absdiff(edges1, edges2, ws.diff);
+        return contour_change_ratio(ws.diff, ws);
+    }
 
-        // Find contours of changes
-        std::vector<std::vector<cv::Point>> contours;
-        cv::findContours(diff, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+    double SlideDetector::contour_change_ratio(const cv::Mat &diff, Workspace &ws) const
+    {
+        // Find contours of changes (the vectors keep their capacity between frames)
+        cv::findContours(diff, ws.contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
 
         double total_change_area = 0.0;
         double frame_area = (double)(diff.rows * diff.cols);
 
-        for (const auto &contour : contours)
+        for (const auto &contour : ws.contours)
         {
             // Get bounding rectangle of the change
             cv::Rect rect = cv::boundingRect(contour);
@@ -66,84 +256,665 @@ namespace ai_interview
         return total_change_area / frame_area;
     }
 
-    std::vector<SlideSegment> SlideDetector::process_video(const std::string &video_path)
+    void SlideDetector::describe_change(const ReferenceSlide &reference, const cv::Mat &edges,
+                                        const AnalysisRegion &region, SlideSegment &segment) const
     {
-        cv::VideoCapture cap(video_path);
-        if (!cap.isOpened())
+        // Reference edges on the host, whatever the metric / backend keeps
+        cv::Mat previous = reference.edges;
+        if (compute_backend_ == ComputeBackend::OpenCL)
+            reference.u_edges.copyTo(previous);
+        else if (change_metric_ == ChangeMetric::PackedTiles)
+            unpack_edges(reference.packed, previous);
+        if (previous.empty() || previous.size() != edges.size())
+            return;
+
+        // Build-up: (nearly) every edge of the previous slide is still there
+        cv::Mat removed;
+        cv::bitwise_not(edges, removed);
+        cv::bitwise_and(previous, removed, removed);
+        const int previous_count = cv::countNonZero(previous);
+        segment.is_build_up = previous_count > 0 && cv::countNonZero(removed) <= BUILD_UP_MAX_REMOVED * previous_count;
+
+        // Same difference as the Contours metric, with nearby changes joined into one region
+        cv::Mat diff;
+        cv::absdiff(previous, edges, diff);
+        cv::dilate(diff, diff, join_kernel_);
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(diff, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+        const double min_area = CHANGE_REGION_MIN_AREA * static_cast<double>(edges.total());
+        std::vector<cv::Rect> rects;
+        for (const auto &contour : contours)
         {
-            throw std::runtime_error("Could not open video: " + video_path);
+            const cv::Rect rect = cv::boundingRect(contour);
+            if (rect.area() >= min_area)
+                rects.push_back(rect);
         }
 
-        frame_width_ = (int)cap.get(cv::CAP_PROP_FRAME_WIDTH);
-        frame_height_ = (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT);
-        double fps = cap.get(cv::CAP_PROP_FPS);
+        // Bounding rects of separate contours can still overlap: merge until they don't
+        for (bool merged = true; merged;)
+        {
+            merged = false;
+            for (size_t i = 0; i < rects.size() && !merged; i++)
+            {
+                for (size_t j = i + 1; j < rects.size(); j++)
+                {
+                    if ((rects[i] & rects[j]).area() > 0)
+                    {
+                        rects[i] |= rects[j];
+                        rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(j));
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+        std::sort(rects.begin(), rects.end(), [](const cv::Rect &a, const cv::Rect &b)
+                  { return a.y != b.y ? a.y < b.y : a.x < b.x; });
 
-        std::vector<SlideSegment> segments;
-        cv::Mat last_saved_edges; // Store edges of the last saved slide
-        cv::Mat frame;
+        // Analysis pixels of the include area -> fractions of the frame
+        const double sx = region.include.width / edges.cols;
+        const double sy = region.include.height / edges.rows;
+        segment.changed_regions.clear();
+        for (const auto &r : rects)
+            segment.changed_regions.emplace_back(region.include.x + r.x * sx, region.include.y + r.y * sy,
+                                                 r.width * sx, r.height * sy);
+    }
+
+    void SlideDetector::compute_thumbnail(const cv::Mat &frame, Workspace &ws, cv::Mat &thumb) const
+    {
+        // The thumbnail shows the include area only
+        const cv::Mat input = ws.region.is_full_frame() ? frame : frame(region_to_pixels(ws.region.include, frame.size()));
+
+        // Downscale first (INTER_AREA averages blocks, which also kills compression noise),
+        // then convert only 64x36 pixels to gray
+        if (input.channels() == 1)
+        {
+            cv::resize(input, thumb, cv::Size(COARSE_THUMB_WIDTH, COARSE_THUMB_HEIGHT), 0, 0, cv::INTER_AREA);
+        }
+        else
+        {
+            cv::resize(input, ws.small, cv::Size(COARSE_THUMB_WIDTH, COARSE_THUMB_HEIGHT), 0, 0, cv::INTER_AREA);
+            cv::cvtColor(ws.small, thumb, cv::COLOR_BGR2GRAY);
+        }
+        mask_excluded(thumb, ws);
+    }
+
+    double SlideDetector::calculate_thumbnail_diff(const cv::Mat &thumb1, const cv::Mat &thumb2) const
+    {
+        if (thumb1.empty() || thumb2.empty())
+            return 255.0;
+
+        // Mean absolute difference in gray levels (0 - 255)
+        return cv::norm(thumb1, thumb2, cv::NORM_L1) / static_cast<double>(thumb1.total());
+    }
+
+    bool SlideDetector::cache_key(const VideoSource &video, uint64_t extra, ResultCacheKey &key) const
+    {
+        if (cache_dir_.empty())
+            return false;
+
+        // A callback stream would have to be read twice: not cached
+        bool fingerprinted = false;
+        if (video.kind() == VideoSource::Kind::File)
+            fingerprinted = fingerprint_video_file(video.path(), key.content);
+        else if (video.kind() == VideoSource::Kind::Memory)
+            fingerprinted = fingerprint_video_buffer(video.data(), video.size(), key.content);
+        if (!fingerprinted)
+            return false;
+
+        // Everything that can change the segments. Threads / chunks give identical results.
+        const double params[] = {
+            min_duration_, min_area_ratio_,
+            static_cast<double>(DEFAULT_RESIZE_WIDTH), static_cast<double>(GAUSSIAN_BLUR_SIZE),
+            static_cast<double>(CANNY_THRESHOLD_LOW), static_cast<double>(CANNY_THRESHOLD_HIGH),
+            static_cast<double>(DILATION_KERNEL_SIZE),
+            static_cast<double>(COARSE_THUMB_WIDTH), static_cast<double>(COARSE_THUMB_HEIGHT),
+            static_cast<double>(CHANGE_TILE_SIZE), static_cast<double>(CHANGE_TILE_MIN_PIXELS),
+            static_cast<double>(frame_stride_), target_analysis_fps_, coarse_threshold_,
+            static_cast<double>(change_metric_), static_cast<double>(compute_backend_),
+            static_cast<double>(decode_acceleration_), static_cast<double>(reduced_decode_),
+            static_cast<double>(revisit_history_), auto_exclude_sec_,
+            static_cast<double>(CHANGE_REGION_JOIN_SIZE), CHANGE_REGION_MIN_AREA, BUILD_UP_MAX_REMOVED,
+            adaptive_sensitivity_, static_cast<double>(ADAPTIVE_WARMUP_FRAMES), ADAPTIVE_MIN_RATIO,
+            ADAPTIVE_MAX_RATIO};
 
-        int frame_idx = 0;
-        double last_slide_time = -min_duration_; // So the first frame can become a slide
+        // Region rectangles (variable count)
+        std::vector<double> region = {region_.include.x, region_.include.y, region_.include.width, region_.include.height};
+        for (const auto &r : region_.exclude)
+            region.insert(region.end(), {r.x, r.y, r.width, r.height});
 
-        while (cap.read(frame))
+        key.params = hash_bytes(params, sizeof(params),
+                                hash_bytes(region.data(), region.size() * sizeof(double), extra));
+        return true;
+    }
+
+    std::vector<SlideSegment> SlideDetector::process_video(const VideoSource &video, ScanStats *stats) const
+    {
+        return process_video(video, ScanObserver(), stats);
+    }
+
+    std::vector<SlideSegment> SlideDetector::process_video(const VideoSource &video, const ScanObserver &observer,
+                                                           ScanStats *stats) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (stats)
         {
-            // Optimization: process not every frame, but for example every 5th,
-            // if video is 30-60 fps. But for now we take every frame to keep it simple.
+            *stats = ScanStats();
+            stats->start_rss_bytes = current_rss_bytes();
+        }
+
+        ResultCacheKey key;
+        const bool use_cache = cache_key(video, 0, key);
 
-            // Get edge map of current frame
-            // Resize for speed (process at 720p even if video is 4k)
-            cv::Mat resized;
-            float scale = 1.0;
-            if (frame.cols > DEFAULT_RESIZE_WIDTH)
+        ScanReporter reporter(observer);
+        std::vector<CapturedSlide> cached;
+        std::vector<SlideSegment> segments;
+        if (use_cache && load_cached_result(result_cache_path(cache_dir_, key), key, cached))
+        {
+            segments.reserve(cached.size());
+            for (const auto &slide : cached)
             {
-                scale = static_cast<float>(DEFAULT_RESIZE_WIDTH) / frame.cols;
-                cv::resize(frame, resized, cv::Size(), scale, scale);
+                segments.push_back(slide.segment);
+                reporter.segment(slide.segment);
             }
-            else
+            if (stats)
+                stats->cache_hit = true;
+        }
+        else
+        {
+            SlideCallback report;
+            if (reporter.wants_segments())
+                report = [&reporter](const SlideSegment &segment, const cv::Mat &)
+                { reporter.segment(segment); };
+            segments = scan_video(video, report, false, stats, &reporter);
+            if (use_cache)
             {
-                resized = frame;
+                for (const auto &segment : segments)
+                    cached.push_back(CapturedSlide{segment, cv::Mat(), {}, {}, {}});
+                store_cached_result(result_cache_path(cache_dir_, key), key, cached);
             }
+        }
+        reporter.finish();
 
-            cv::Mat current_edges = compute_edge_map(resized);
-            double timestamp = frame_idx / fps;
+        if (stats)
+        {
+            reporter.sample_memory();
+            stats->peak_rss_bytes = reporter.peak_rss();
+            stats->slides = segments.size();
+            stats->wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return segments;
+    }
+
+    std::vector<CapturedSlide> SlideDetector::process_video_with_frames(const VideoSource &video,
+                                                                        const FrameCaptureOptions &options,
+                                                                        ScanStats *stats) const
+    {
+        return process_video_with_frames(video, options, ScanObserver(), stats);
+    }
+
+    std::vector<CapturedSlide> SlideDetector::process_video_with_frames(const VideoSource &video,
+                                                                        const FrameCaptureOptions &options,
+                                                                        const ScanObserver &observer,
+                                                                        ScanStats *stats) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (stats)
+        {
+            *stats = ScanStats();
+            stats->start_rss_bytes = current_rss_bytes();
+        }
+
+        // Capture options are part of the key (seed 0 is process_video, which has no images)
+        const int option_values[] = {1, options.max_width, options.jpeg_quality,
+                                     options.text_regions, options.text.deskew, options.text.binarize,
+                                     options.text.padding};
+        uint64_t extra = hash_bytes(options.encoding.data(), options.encoding.size(),
+                                    hash_bytes(option_values, sizeof(option_values)));
+        if (options.text_regions)
+        {
+            const double text_values[] = {
+                SLIDE_OUTLINE_MIN_AREA, SLIDE_OUTLINE_APPROX, SLIDE_OUTLINE_MAX_OUTSIDE,
+                static_cast<double>(TEXT_JOIN_KERNEL_WIDTH), static_cast<double>(TEXT_JOIN_KERNEL_HEIGHT),
+                static_cast<double>(TEXT_MIN_BLOCK_HEIGHT), TEXT_MIN_EDGE_DENSITY};
+            extra = hash_bytes(text_values, sizeof(text_values), extra);
+        }
+
+        // With a memory budget raw results are not cached: an entry is loaded all at once, so every
+        // full BGR keyframe would be in memory regardless of the keyframe budget
+        ResultCacheKey key;
+        const bool use_cache = cache_key(video, extra, key) && !(memory_budget_ > 0 && options.encoding.empty());
+
+        ScanReporter reporter(observer);
+        std::vector<CapturedSlide> slides;
+        if (use_cache && load_cached_result(result_cache_path(cache_dir_, key), key, slides))
+        {
+            // Same keyframe budget as a scan: encoded images over it are spilled
+            size_t held_bytes = 0;
+            const std::string spill_prefix = make_spill_prefix();
+            for (auto &slide : slides)
+            {
+                budget_keyframe(slide, options.encoding, spill_prefix, held_bytes);
+                reporter.slide(slide);
+            }
+            if (stats)
+                stats->cache_hit = true;
+        }
+        else
+        {
+            slides = capture_slides(video, options, stats, &reporter);
+            // Spilled files belong to the caller, who may delete them: the cache must not point to them
+            const bool spilled = std::any_of(slides.begin(), slides.end(), [](const CapturedSlide &slide)
+                                             { return !slide.spill_path.empty(); });
+            if (use_cache && !spilled)
+                store_cached_result(result_cache_path(cache_dir_, key), key, slides);
+        }
+        reporter.finish();
 
-            if (last_saved_edges.empty())
+        if (stats)
+        {
+            reporter.sample_memory();
+            stats->peak_rss_bytes = reporter.peak_rss();
+            stats->slides = slides.size();
+            stats->wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return slides;
+    }
+
+    std::vector<CapturedSlide> SlideDetector::capture_slides(const VideoSource &video,
+                                                             const FrameCaptureOptions &options,
+                                                             ScanStats *stats, ScanReporter *reporter) const
+    {
+        std::vector<int> encode_params;
+        if (options.encoding == ".jpg" || options.encoding == ".jpeg")
+            encode_params = {cv::IMWRITE_JPEG_QUALITY, options.jpeg_quality};
+
+        std::vector<CapturedSlide> slides;
+        AnalysisRegion region = region_; // Set by scan_video before the first capture
+
+        // Memory budget: keyframes over their share go to disk, under a name unique to this call
+        size_t held_bytes = 0;
+        const std::string spill_prefix = make_spill_prefix();
+
+        auto capture = [&](const SlideSegment &segment, const cv::Mat &frame)
+        {
+            CapturedSlide slide{segment, cv::Mat(), {}, {}, {}};
+
+            // The decoder reuses its output buffer, so we must take our own copy here
+            cv::Mat image;
+            if (options.max_width > 0 && frame.cols > options.max_width)
             {
-                // Always consider the first frame as the beginning of the first slide
-                segments.push_back({frame_idx, timestamp, 1.0});
-                last_slide_time = timestamp;
-                last_saved_edges = current_edges.clone(); // Remember as reference
+                double scale = static_cast<double>(options.max_width) / frame.cols;
+                cv::resize(frame, image, cv::Size(), scale, scale, cv::INTER_AREA);
             }
             else
             {
-                // COMPARE WITH REFERENCE, NOT WITH PREVIOUS FRAME
-                double change_score = calculate_change_metric(last_saved_edges, current_edges);
+                image = frame.clone();
+            }
 
-                // DETECTION LOGIC:
-                // 1. Change is greater than threshold (min_area_ratio)
-                // 2. Enough time has passed since last slide (min_duration)
-                if (change_score > min_area_ratio_ && (timestamp - last_slide_time) >= min_duration_)
+            if (options.encoding.empty())
+            {
+                slide.frame = image;
+            }
+            else if (!cv::imencode(options.encoding, image, slide.encoded, encode_params))
+            {
+                throw std::runtime_error("Could not encode slide frame as " + options.encoding);
+            }
+
+            // From the full-resolution frame: OCR gains from every pixel of small text
+            if (options.text_regions)
+            {
+                slide.text_regions = extract_text_regions(frame, options.text, region).regions;
+                if (!options.encoding.empty())
                 {
-                    segments.push_back({frame_idx, timestamp, change_score});
-                    last_slide_time = timestamp;
-                    last_saved_edges = current_edges.clone(); // Update reference only on slide change
+                    for (auto &text : slide.text_regions)
+                    {
+                        if (!cv::imencode(options.encoding, text.image, text.encoded, encode_params))
+                            throw std::runtime_error("Could not encode text region as " + options.encoding);
+                        text.image.release();
+                    }
                 }
             }
 
-            frame_idx++;
+            budget_keyframe(slide, options.encoding, spill_prefix, held_bytes);
+
+            slides.push_back(std::move(slide));
+            reporter->slide(slides.back());
+        };
+
+        if (!reduced_decode_)
+        {
+            scan_video(video, capture, true, stats, reporter, &region);
+            return slides;
+        }
+
+        // The scan only sees small gray frames: decode the full-resolution slides afterwards
+        std::vector<SlideSegment> segments = scan_video(video, nullptr, false, stats, reporter, &region);
+        std::vector<int> indices;
+        indices.reserve(segments.size());
+        for (const auto &segment : segments)
+            indices.push_back(segment.frame_index);
+
+        // One frame at a time (not get_frames): only the captured copies are held
+        cv::VideoCapture cap;
+        open_capture(cap, video);
+        visit_frames(cap, indices, [&](size_t slot, const cv::Mat &frame)
+                     { capture(segments[slot], frame); });
+        return slides;
+    }
+
+    std::vector<SlideSegment> SlideDetector::scan_video(const VideoSource &video, const SlideCallback &on_slide,
+                                                        bool needs_frames, ScanStats *stats, ScanReporter *reporter,
+                                                        AnalysisRegion *scan_region) const
+    {
+        // Webcam overlay auto-detection reads the first seconds on its own capture. It is closed
+        // before the scan opens the video: an in-place reader can't be read by two captures at once.
+        const AnalysisRegion region = detect_analysis_region(video);
+        if (scan_region)
+            *scan_region = region;
+
+        cv::VideoCapture cap;
+        open_capture(cap, video);
+
+        double fps = cap.get(cv::CAP_PROP_FPS);
+
+        int total_frames = (int)cap.get(cv::CAP_PROP_FRAME_COUNT);
+        if (reporter)
+            reporter->set_total_frames(std::max(0, total_frames));
+
+        // Adaptive threshold: a chunk can't start from the real noise statistics
+        int num_chunks = 0;
+        if (num_chunks_ > 1 && adaptive_sensitivity_ == 0.0 && fps > 0.0 && total_frames > 0 &&
+            video.supports_concurrent_open())
+            num_chunks = std::min(num_chunks_, static_cast<int>(total_frames / (fps * MIN_CHUNK_DURATION_SEC)));
+
+        // Every chunk decodes on its own: one frame in flight per chunk
+        const int frame_width = (int)cap.get(cv::CAP_PROP_FRAME_WIDTH);
+        const int frame_height = (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT);
+        if (num_chunks > 1 && frame_memory_budget() > 0 && frame_width > 0 && frame_height > 0)
+        {
+            const size_t frame_bytes = static_cast<size_t>(frame_width) * frame_height * 3;
+            num_chunks = static_cast<int>(std::min<size_t>(num_chunks, frame_memory_budget() / frame_bytes));
         }
 
+        if (num_chunks > 1)
+        {
+            // Every chunk opens its own capture
+            cap.release();
+            return scan_chunked(video, fps, total_frames, num_chunks, region, on_slide, needs_frames, stats,
+                                reporter);
+        }
+
+        // fps is taken from the normal capture: GStreamer may not report the same metadata
+        if (reduced_decode_)
+            open_reduced_capture(cap, video);
+
+        int num_threads = resolved_num_threads();
+        std::vector<SlideSegment> segments = num_threads > 1
+                                                 ? scan_pipelined(cap, fps, num_threads, region, on_slide, stats, reporter)
+                                                 : scan_serial(cap, fps, region, on_slide, stats, reporter);
+
         cap.release();
         return segments;
     }
 
-    cv::Mat SlideDetector::get_frame(const std::string &video_path, int frame_index)
+    void SlideDetector::analyze_frame(const cv::Mat &frame, const ReferencePtr &reference, FrameAnalysis &analysis,
+                                      Workspace &ws) const
+    {
+        // The region of a workspace is fixed for its scan, so the variant is picked once
+        if (!ws.kernel)
+            ws.kernel = select_analyze_kernel(ws.region);
+        (this->*ws.kernel)(frame, reference, analysis, ws);
+    }
+
+    const cv::Mat &SlideDetector::host_edge_map(const FrameAnalysis &analysis, cv::Mat &buffer) const
+    {
+        if (compute_backend_ == ComputeBackend::OpenCL)
+        {
+            analysis.u_edges.copyTo(buffer);
+            return buffer;
+        }
+        // The packed kernel dilates the 1-bit map directly and never fills the 8-bit one
+        if (!analysis.has_edges && analysis.has_packed)
+        {
+            unpack_edges(analysis.packed, buffer);
+            return buffer;
+        }
+        return analysis.edges;
+    }
+
+    const cv::Mat &SlideDetector::prepare_input(const cv::Mat &frame, Workspace &ws) const
+    {
+        // Crop to the include area first (a view, no copy), so the rest of the frame costs nothing
+        ws.cropped = ws.region.is_full_frame() ? frame : frame(region_to_pixels(ws.region.include, frame.size()));
+
+        // Resize for speed (process at 720p even if video is 4k). The scale is that of the
+        // whole frame, so a cropped slide keeps the same pixel size as an uncropped one.
+        if (frame.cols <= DEFAULT_RESIZE_WIDTH)
+            return ws.cropped;
+
+        ScopedStageTimer timer(ws.stats, ScanStage::Resize);
+        float scale = static_cast<float>(DEFAULT_RESIZE_WIDTH) / frame.cols;
+        cv::resize(ws.cropped, ws.resized, cv::Size(), scale, scale);
+        return ws.resized;
+    }
+
+    SlideDetector::StageBuffers::StageBuffers() : ws_(std::make_unique<Workspace>()) {}
+    SlideDetector::StageBuffers::~StageBuffers() = default;
+    SlideDetector::StageBuffers::StageBuffers(StageBuffers &&) noexcept = default;
+    SlideDetector::StageBuffers &SlideDetector::StageBuffers::operator=(StageBuffers &&) noexcept = default;
+
+    cv::Mat SlideDetector::resize_frame(const cv::Mat &frame, StageBuffers &buffers) const
+    {
+        buffers.ws_->region = region_;
+        return prepare_input(frame, *buffers.ws_);
+    }
+
+    void SlideDetector::edge_map(const cv::Mat &analysis_frame, cv::Mat &edges, StageBuffers &buffers) const
+    {
+        buffers.ws_->region = region_;
+        compute_edge_map(analysis_frame, *buffers.ws_, edges);
+        mask_excluded(edges, *buffers.ws_);
+    }
+
+    double SlideDetector::change_ratio(const cv::Mat &edges1, const cv::Mat &edges2, StageBuffers &buffers) const
+    {
+        Workspace &ws = *buffers.ws_;
+        ws.region = region_;
+        if (change_metric_ == ChangeMetric::PackedTiles)
+        {
+            PackedEdges packed1, packed2;
+            pack_edges(edges1, packed1);
+            pack_edges(edges2, packed2);
+            return normalize_to_coverage(packed_tile_change_ratio(packed1, packed2, ws.tile_counts), edges1.size(), ws);
+        }
+        return normalize_to_coverage(calculate_change_metric(edges1, edges2, ws), edges1.size(), ws);
+    }
+
+    SlideDetector::DetectionState SlideDetector::make_detection_state(const AnalysisRegion &region) const
+    {
+        DetectionState state;
+        state.last_slide_time = -min_duration_; // So the first frame can become a slide
+        state.revisits = RevisitIndex(revisit_history_, min_area_ratio_);
+        state.region = region;
+        return state;
+    }
+
+    void SlideDetector::tag_revisits(std::vector<SlideSegment> &segments, std::vector<PackedEdges> &occupancy) const
+    {
+        RevisitIndex revisits(revisit_history_, min_area_ratio_);
+        for (size_t i = 0; i < segments.size(); i++)
+            revisits.classify(segments[i], i < occupancy.size() ? occupancy[i] : PackedEdges());
+    }
+
+    double SlideDetector::trigger_threshold(const DetectionState &state) const
+    {
+        if (adaptive_sensitivity_ > 0.0 && state.noise.count() >= static_cast<uint64_t>(ADAPTIVE_WARMUP_FRAMES))
+            return state.noise.threshold(adaptive_sensitivity_);
+        return min_area_ratio_;
+    }
+
+    bool SlideDetector::apply_decision(DetectionState &state, int frame_idx, double timestamp, FrameAnalysis &analysis) const
     {
-        cv::VideoCapture cap(video_path);
-        if (!cap.isOpened())
+        if (!state.reference)
         {
-            throw std::runtime_error("Could not open video: " + video_path);
+            // Always consider the first frame as the beginning of the first slide
+            state.segments.push_back({frame_idx, timestamp, 1.0});
         }
+        else
+        {
+            // DETECTION LOGIC:
+            // 1. Enough time has passed since last slide (min_duration)
+            // 2. Change is greater than threshold (min_area_ratio or the video's noise floor)
+            // The time check comes first: the serial scan never scores those frames, so the noise
+            // statistics may not see them in the other modes either.
+            if ((timestamp - state.last_slide_time) < min_duration_ || analysis.is_static)
+                return false;
+
+            const double threshold = trigger_threshold(state);
+            if (adaptive_sensitivity_ > 0.0)
+                state.noise.add(analysis.change_score);
+            if (analysis.change_score <= threshold)
+                return false;
+
+            state.segments.push_back({frame_idx, timestamp, analysis.change_score});
+        }
+
+        // Edge map of the new slide on the host (OpenCL keeps it on the device, PackedTiles packed)
+        cv::Mat host_edges;
+        const cv::Mat *edges = &host_edge_map(analysis, host_edges);
+
+        // What was added / changed since the previous slide
+        if (state.reference)
+            describe_change(*state.reference, *edges, state.region, state.segments.back());
+
+        // Revisit tracking: occupancy map of the new slide (2 KB) against the last distinct slides
+        PackedEdges occupancy;
+        if (revisit_history_ > 0)
+        {
+            cv::Mat blocks;
+            compute_occupancy_map(*edges, blocks, occupancy);
+            state.occupancy.push_back(occupancy);
+        }
+        state.revisits.classify(state.segments.back(), std::move(occupancy));
+
+        // Remember as reference (updated only on slide change).
+        // The buffers are handed over, not cloned: the analysis allocates new ones on the next frame.
+        auto reference = std::make_shared<ReferenceSlide>();
+        if (compute_backend_ == ComputeBackend::OpenCL)
+        {
+            // Device buffers: the reference never leaves the GPU
+            reference->u_edges = std::move(analysis.u_edges);
+            reference->u_thumb = std::move(analysis.u_thumb);
+        }
+        else if (change_metric_ == ChangeMetric::PackedTiles)
+        {
+            // Only the 1-bit map is kept; the 8-bit buffer stays with the analysis for reuse
+            reference->packed = std::move(analysis.packed);
+            reference->thumb = std::move(analysis.thumb);
+        }
+        else
+        {
+            reference->edges = std::move(analysis.edges);
+            reference->thumb = std::move(analysis.thumb);
+        }
+        analysis.has_thumb = analysis.has_edges = analysis.has_packed = false;
+        state.reference = std::move(reference);
+        state.last_slide_time = timestamp;
+        return true;
+    }
+
+    std::vector<SlideSegment> SlideDetector::scan_serial(cv::VideoCapture &cap, double fps, const AnalysisRegion &region,
+                                                         const SlideCallback &on_slide, ScanStats *stats,
+                                                         ScanReporter *reporter) const
+    {
+        DetectionState state = make_detection_state(region);
+        state.reporter = reporter;
+        scan_range(cap, fps, 0, -1, state, on_slide, nullptr);
+        if (stats)
+            stats->merge(state.stats);
+        return std::move(state.segments);
+    }
+
+    bool SlideDetector::timed_grab(cv::VideoCapture &cap, ScanStats &stats)
+    {
+        ScopedStageTimer timer(stats, ScanStage::Decode);
+        if (!cap.grab())
+            return false;
+        stats.frames_decoded++;
+        return true;
+    }
+
+    bool SlideDetector::timed_retrieve(cv::VideoCapture &cap, cv::Mat &frame, ScanStats &stats)
+    {
+        ScopedStageTimer timer(stats, ScanStage::Convert);
+        return cap.retrieve(frame);
+    }
+
+    bool SlideDetector::scan_range(cv::VideoCapture &cap, double fps, int begin_frame, int end_frame,
+                                   DetectionState &state, const SlideCallback &on_slide,
+                                   const std::vector<SlideSegment> *converge_with) const
+    {
+        const int stride = effective_stride(fps);
+
+        cv::Mat frame;
+        FrameAnalysis analysis;
+        Workspace ws;
+        ws.region = state.region;
+
+        // grab() only demuxes/decodes; retrieve() (BGR conversion) is done for analyzed frames only
+        bool converged = false;
+        for (int frame_idx = begin_frame; (end_frame < 0 || frame_idx < end_frame) && timed_grab(cap, ws.stats); frame_idx++)
+        {
+            if (state.reporter)
+                state.reporter->frame_decoded();
+
+            if (frame_idx % stride != 0)
+            {
+                ws.stats.frames_skipped++;
+                continue;
+            }
+
+            double timestamp = frame_idx / fps;
+
+            // A new slide can't be emitted before min_duration has passed,
+            // so there is no point in even converting this frame
+            if (state.reference && (timestamp - state.last_slide_time) < min_duration_)
+            {
+                ws.stats.frames_skipped++;
+                continue;
+            }
+
+            if (!timed_retrieve(cap, frame, ws.stats))
+                break;
+
+            analysis.reset();
+            analyze_frame(frame, state.reference, analysis, ws);
+
+            if (!apply_decision(state, frame_idx, timestamp, analysis))
+                continue;
+
+            if (on_slide)
+                on_slide(state.segments.back(), frame);
+
+            if (converge_with &&
+                std::any_of(converge_with->begin(), converge_with->end(), [&](const SlideSegment &s)
+                            { return s.frame_index == frame_idx; }))
+            {
+                converged = true;
+                break;
+            }
+        }
+
+        state.stats.merge(ws.stats);
+        return converged;
+    }
+
+    cv::Mat SlideDetector::get_frame(const VideoSource &video, int frame_index) const
+    {
+        cv::VideoCapture cap;
+        open_capture(cap, video);
 
         // Jump directly to the needed frame (seek)
         cap.set(cv::CAP_PROP_POS_FRAMES, frame_index);
@@ -153,4 +924,68 @@ namespace ai_interview
         return frame; // Если кадр не считан, вернется пустой Mat, это ок
     }
 
+    std::vector<cv::Mat> SlideDetector::get_frames(const VideoSource &video, std::vector<int> frame_indices) const
+    {
+        std::vector<cv::Mat> frames(frame_indices.size());
+        if (frame_indices.empty())
+            return frames;
+
+        cv::VideoCapture cap;
+        open_capture(cap, video);
+        visit_frames(cap, frame_indices, [&](size_t slot, const cv::Mat &frame)
+                     { frames[slot] = frame; });
+        cap.release();
+        return frames;
+    }
+
+    void SlideDetector::visit_frames(cv::VideoCapture &cap, const std::vector<int> &frame_indices,
+                                     const std::function<void(size_t, const cv::Mat &)> &on_frame) const
+    {
+        // Visit requests in ascending frame order, but remember where each one goes in the output
+        std::vector<size_t> order(frame_indices.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return frame_indices[a] < frame_indices[b]; });
+
+        int pos = 0; // Index of the frame that the next grab() will return
+        cv::Mat frame;
+        int decoded_idx = -1;
+
+        for (size_t slot : order)
+        {
+            int target = frame_indices[slot];
+            if (target < 0)
+                continue;
+
+            // Duplicate request - reuse the frame we already decoded
+            if (target == decoded_idx)
+            {
+                on_frame(slot, frame);
+                continue;
+            }
+
+            // Far jump: seeking to the nearest keyframe is cheaper than decoding everything in between
+            if (target - pos > BATCH_SEEK_GAP_FRAMES)
+            {
+                cap.set(cv::CAP_PROP_POS_FRAMES, target);
+                pos = target;
+            }
+
+            // Skip frames without converting them to BGR
+            bool ok = true;
+            while (pos < target && (ok = cap.grab()))
+                pos++;
+
+            if (!ok || !cap.grab())
+                break; // End of video: the remaining (larger) indices stay empty
+            pos++;
+
+            // New Mat each time: the previous one is already handed out to the caller
+            frame = cv::Mat();
+            cap.retrieve(frame);
+            decoded_idx = target;
+            on_frame(slot, frame);
+        }
+    }
+
 } // namespace ai_interview
\ No newline at end of file
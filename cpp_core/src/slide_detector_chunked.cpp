@@ -0,0 +1,201 @@
+#include "ai_interview/slide_detector.hpp"
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+// Chunked implementation of SlideDetector::scan_video for long videos.
+//
+// The video is split into K frame ranges. Each range is scanned in parallel on its own
+// cv::VideoCapture, starting from an empty state ("speculative" run: the first analyzed
+// frame of every chunk becomes a slide).
+//
+// The merge then walks the chunks in order. Chunk 0 is exact. For chunk k>0 the range is
+// re-scanned with the real state left by chunk k-1 (reference edges + last slide time) until
+// that run emits a segment at a frame where the speculative run also emitted one. The state
+// after emitting at a given frame doesn't depend on the past, so from that point the
+// speculative result is exact and is used as is. Usually this re-scan covers only the few
+// seconds up to the first real slide change in the chunk.
+//
+// With a memory budget the speculative slide frames are not kept (a chunk may capture many that the
+// merge drops): the final slides are decoded once more after the merge. Scans that only report
+// segments (process_video) need no frames at all.
+
+namespace ai_interview
+{
+
+    std::vector<SlideSegment> SlideDetector::scan_chunked(const VideoSource &video, double fps, int total_frames,
+                                                          int num_chunks, const AnalysisRegion &region,
+                                                          const SlideCallback &on_slide, bool needs_frames,
+                                                          ScanStats *stats, ScanReporter *reporter) const
+    {
+        struct Chunk
+        {
+            int begin_frame = 0;
+            int end_frame = 0;
+            DetectionState state;               // Speculative run
+            std::map<int, cv::Mat> slide_frames; // frame_index -> captured frame (only with needs_frames, no memory budget)
+            std::exception_ptr error;
+        };
+
+        // Opens the video and positions it at begin_frame.
+        // CAP_PROP_POS_FRAMES seeks to the preceding keyframe and decodes forward to the exact frame.
+        auto open_at = [&](cv::VideoCapture &cap, int begin_frame)
+        {
+            open_capture(cap, video);
+            if (begin_frame > 0)
+                cap.set(cv::CAP_PROP_POS_FRAMES, begin_frame);
+        };
+
+        // Frames are only needed for process_video_with_frames. They are kept per chunk and handed
+        // to on_slide after the merge, because speculative segments may be dropped.
+        const bool keep_frames = on_slide && needs_frames && memory_budget_ == 0;
+        auto capture_into = [&](std::map<int, cv::Mat> &frames) -> SlideCallback
+        {
+            if (!keep_frames)
+                return nullptr;
+            return [&frames](const SlideSegment &segment, const cv::Mat &frame)
+            { frames[segment.frame_index] = frame.clone(); };
+        };
+
+        std::vector<Chunk> chunks(num_chunks);
+        for (int k = 0; k < num_chunks; k++)
+        {
+            chunks[k].begin_frame = static_cast<int>(static_cast<long long>(total_frames) * k / num_chunks);
+            chunks[k].end_frame = static_cast<int>(static_cast<long long>(total_frames) * (k + 1) / num_chunks);
+        }
+        chunks.back().end_frame = -1; // Last chunk reads until EOF (the frame count is only an estimate)
+
+        // 1. Speculative runs, one thread per chunk
+        std::vector<std::thread> threads;
+        threads.reserve(num_chunks);
+        std::exception_ptr spawn_error;
+        try
+        {
+            for (auto &chunk : chunks)
+            {
+                threads.emplace_back([&, this]()
+                                     {
+                    try
+                    {
+                        cv::VideoCapture cap;
+                        open_at(cap, chunk.begin_frame);
+                        chunk.state = make_detection_state(region);
+                        chunk.state.reporter = reporter; // Boundary re-scans below are not counted again
+                        scan_range(cap, fps, chunk.begin_frame, chunk.end_frame, chunk.state,
+                                   capture_into(chunk.slide_frames), nullptr);
+                    }
+                    catch (...)
+                    {
+                        chunk.error = std::current_exception();
+                    } });
+            }
+        }
+        catch (...)
+        {
+            spawn_error = std::current_exception();
+        }
+        for (auto &t : threads)
+            t.join();
+
+        if (spawn_error)
+            std::rethrow_exception(spawn_error);
+
+        for (auto &chunk : chunks)
+        {
+            if (chunk.error)
+                std::rethrow_exception(chunk.error);
+        }
+
+        // Speculative runs + boundary re-scans
+        ScanStats total;
+        for (const auto &chunk : chunks)
+            total.merge(chunk.state.stats);
+
+        // 2. Merge: re-check every boundary against the previous chunk's final state
+        std::vector<SlideSegment> segments = std::move(chunks[0].state.segments);
+        std::vector<PackedEdges> occupancy = std::move(chunks[0].state.occupancy); // Parallel to segments (revisits)
+        std::map<int, cv::Mat> slide_frames = std::move(chunks[0].slide_frames);
+        DetectionState carried = std::move(chunks[0].state); // Exact state at the end of the merged prefix
+
+        for (int k = 1; k < num_chunks; k++)
+        {
+            Chunk &chunk = chunks[k];
+
+            DetectionState exact;
+            exact.region = region;
+            exact.reference = carried.reference;
+            exact.last_slide_time = carried.last_slide_time;
+
+            cv::VideoCapture cap;
+            open_at(cap, chunk.begin_frame);
+            bool converged = scan_range(cap, fps, chunk.begin_frame, chunk.end_frame, exact,
+                                        capture_into(slide_frames), &chunk.state.segments);
+            cap.release();
+            total.merge(exact.stats);
+
+            segments.insert(segments.end(), exact.segments.begin(), exact.segments.end());
+            occupancy.insert(occupancy.end(), exact.occupancy.begin(), exact.occupancy.end());
+
+            if (converged)
+            {
+                // Both runs emitted at this frame. Keep the rest of the speculative result.
+                int sync_frame = exact.segments.back().frame_index;
+                for (size_t i = 0; i < chunk.state.segments.size(); i++)
+                {
+                    const SlideSegment &segment = chunk.state.segments[i];
+                    if (segment.frame_index > sync_frame)
+                    {
+                        segments.push_back(segment);
+                        if (i < chunk.state.occupancy.size())
+                            occupancy.push_back(std::move(chunk.state.occupancy[i]));
+                        if (keep_frames)
+                            slide_frames[segment.frame_index] = chunk.slide_frames[segment.frame_index];
+                    }
+                }
+                carried.reference = chunk.state.reference;
+                carried.last_slide_time = chunk.state.last_slide_time;
+            }
+            else
+            {
+                // The exact run covered the whole chunk
+                carried.reference = exact.reference;
+                carried.last_slide_time = exact.last_slide_time;
+            }
+        }
+
+        if (stats)
+            stats->merge(total);
+
+        // Chunks numbered their slides independently: renumber over the whole video
+        tag_revisits(segments, occupancy);
+
+        if (keep_frames)
+        {
+            for (const auto &segment : segments)
+                on_slide(segment, slide_frames[segment.frame_index]);
+        }
+        else if (on_slide && needs_frames)
+        {
+            std::vector<int> indices;
+            indices.reserve(segments.size());
+            for (const auto &segment : segments)
+                indices.push_back(segment.frame_index);
+
+            cv::VideoCapture cap;
+            open_capture(cap, video);
+            visit_frames(cap, indices, [&](size_t slot, const cv::Mat &frame)
+                         { on_slide(segments[slot], frame); });
+        }
+        else if (on_slide)
+        {
+            // Segments only (process_video observers): nothing to decode
+            for (const auto &segment : segments)
+                on_slide(segment, cv::Mat());
+        }
+
+        return segments;
+    }
+
+} // namespace ai_interview
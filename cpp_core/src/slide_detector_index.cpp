@@ -0,0 +1,119 @@
+#include "ai_interview/slide_detector.hpp"
+#include "ai_interview/signal_index.hpp"
+#include <stdexcept>
+
+// SlideDetector::build_signal_index: one decode pass that records the change signal of every
+// sampled frame, so select_segments can re-run the slide selection for other thresholds.
+// Unlike scan_range there is no early min_duration skip: every sampled frame gets a record.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        // 64-bit average hash: 8x8 area-downscaled thumbnail, bit = pixel above the mean
+        uint64_t average_hash(const cv::Mat &thumb, cv::Mat &small)
+        {
+            cv::resize(thumb, small, cv::Size(8, 8), 0, 0, cv::INTER_AREA);
+            const double mean = cv::mean(small)[0];
+
+            uint64_t hash = 0;
+            for (int y = 0; y < 8; y++)
+            {
+                const uchar *row = small.ptr<uchar>(y);
+                for (int x = 0; x < 8; x++)
+                {
+                    if (row[x] > mean)
+                        hash |= 1ULL << (y * 8 + x);
+                }
+            }
+            return hash;
+        }
+    } // namespace
+
+    SignalIndex SlideDetector::build_signal_index(const VideoSource &video) const
+    {
+        // Before the scan capture is opened (in-place readers: one capture at a time)
+        DetectionState state = make_detection_state(detect_analysis_region(video));
+
+        cv::VideoCapture cap;
+        open_capture(cap, video);
+
+        const double fps = cap.get(cv::CAP_PROP_FPS);
+        if (reduced_decode_)
+            open_reduced_capture(cap, video);
+
+        SignalIndex index;
+        index.fps = fps;
+        index.min_scene_duration = min_duration_;
+        index.min_area_ratio = min_area_ratio_;
+
+        const int stride = effective_stride(fps);
+
+        cv::Mat frame;
+        FrameAnalysis analysis;
+        Workspace ws;
+        ws.region = state.region;
+        cv::Mat host_thumb, host_edges, small, blocks;
+        PackedEdges signature;
+        std::vector<uint64_t> reference_signature;
+
+        for (int frame_idx = 0; cap.grab(); frame_idx++)
+        {
+            if (frame_idx % stride != 0)
+                continue;
+            if (!cap.retrieve(frame))
+                break;
+
+            const double timestamp = frame_idx / fps;
+            analysis.reset();
+            analyze_frame(frame, state.reference, analysis, ws);
+
+            SignalRecord record{};
+            record.frame_index = frame_idx;
+            record.reference_frame = state.reference ? state.segments.back().frame_index : -1;
+            record.timestamp_sec = timestamp;
+            record.change_score = analysis.is_static ? 0.0 : analysis.change_score;
+
+            // Thumbnail: reuse the coarse stage's one if it ran (apply_decision moves it away below)
+            const cv::Mat *thumb = &host_thumb;
+            if (compute_backend_ == ComputeBackend::OpenCL && analysis.has_thumb)
+                analysis.u_thumb.copyTo(host_thumb);
+            else if (analysis.has_thumb)
+                thumb = &analysis.thumb;
+            else
+                compute_thumbnail(frame, ws, host_thumb);
+            record.thumb_hash = average_hash(*thumb, small);
+
+            // Static frames have no edge map: by definition they look like the reference
+            if (analysis.is_static)
+            {
+                index.occupancy.insert(index.occupancy.end(), reference_signature.begin(), reference_signature.end());
+            }
+            else
+            {
+                compute_occupancy_map(host_edge_map(analysis, host_edges), blocks, signature);
+
+                if (index.records.empty())
+                {
+                    index.block_rows = signature.rows;
+                    index.block_cols = signature.cols;
+                    index.words_per_row = signature.words_per_row;
+                }
+                else if (signature.rows != index.block_rows || signature.cols != index.block_cols)
+                {
+                    throw std::runtime_error("Frame size changed inside the video: " + video.description());
+                }
+                index.occupancy.insert(index.occupancy.end(), signature.bits.begin(), signature.bits.end());
+            }
+            index.records.push_back(record);
+
+            if (apply_decision(state, frame_idx, timestamp, analysis))
+                reference_signature.assign(index.occupancy.end() - index.signature_words(), index.occupancy.end());
+        }
+
+        cap.release();
+        return index;
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,200 @@
+#include "ai_interview/slide_detector.hpp"
+#include <string>
+
+// Specialized CPU versions of SlideDetector::analyze_frame.
+//
+// The per-frame work depends on three settings: the change metric, whether the coarse stage runs
+// and whether exclude rectangles have to be masked. Each combination is its own instantiation of
+// analyze_frame_cpu<Metric, Coarse, Mask>, with the unused stages compiled out. A workspace picks
+// its variant on the first frame (select_analyze_kernel), so the hot loop makes one indirect call
+// per frame and no configuration checks.
+//
+// The PackedTiles variant never builds the dilated 8-bit edge map: it packs the Canny output and
+// dilates the 1-bit rows (dilate_packed_edges), 64 pixels per operation. The blur stays
+// cv::GaussianBlur, already separable and vectorized for the fixed 5x5 size.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        static_assert(DILATION_KERNEL_SIZE == 3, "dilate_packed_edges implements the 3x3 dilation only");
+
+        // Metric policies
+        struct ContoursMetric
+        {
+            static constexpr ChangeMetric metric = ChangeMetric::Contours;
+            static constexpr const char *name = "contours";
+        };
+        struct TilesMetric
+        {
+            static constexpr ChangeMetric metric = ChangeMetric::Tiles;
+            static constexpr const char *name = "tiles";
+        };
+        struct PackedTilesMetric
+        {
+            static constexpr ChangeMetric metric = ChangeMetric::PackedTiles;
+            static constexpr const char *name = "packed_tiles";
+        };
+
+        // Coarse stage policies
+        struct CoarseStage
+        {
+            static constexpr bool enabled = true;
+            static constexpr const char *name = "coarse";
+        };
+        struct NoCoarseStage
+        {
+            static constexpr bool enabled = false;
+            static constexpr const char *name = "no_coarse";
+        };
+
+        // Exclude mask policies (also drop the coverage normalization, a no-op without excludes)
+        struct WholeArea
+        {
+            static constexpr bool masked = false;
+            static constexpr const char *name = "whole_area";
+        };
+        struct ExcludedArea
+        {
+            static constexpr bool masked = true;
+            static constexpr const char *name = "excluded_area";
+        };
+
+        // Calls pick(Metric{}, Coarse{}, Mask{}) with the policies of these settings
+        template <class Pick>
+        auto with_policies(ChangeMetric metric, bool coarse, bool masked, Pick &&pick)
+        {
+            auto with_mask = [&](auto m, auto c)
+            { return masked ? pick(m, c, ExcludedArea{}) : pick(m, c, WholeArea{}); };
+            auto with_coarse = [&](auto m)
+            { return coarse ? with_mask(m, CoarseStage{}) : with_mask(m, NoCoarseStage{}); };
+
+            switch (metric)
+            {
+            case ChangeMetric::Tiles:
+                return with_coarse(TilesMetric{});
+            case ChangeMetric::PackedTiles:
+                return with_coarse(PackedTilesMetric{});
+            default:
+                return with_coarse(ContoursMetric{});
+            }
+        }
+    } // namespace
+
+    template <class Metric, class Coarse, class Mask>
+    void SlideDetector::analyze_frame_cpu(const cv::Mat &frame, const ReferencePtr &reference,
+                                          FrameAnalysis &analysis, Workspace &ws) const
+    {
+        analysis.reference = reference;
+        analysis.is_static = false;
+        analysis.change_score = 1.0;
+        ws.stats.frames_analyzed++;
+
+        // Coarse stage: if the thumbnail barely differs from the reference slide, nothing changed
+        if constexpr (Coarse::enabled)
+        {
+            if (!analysis.has_thumb)
+            {
+                ScopedStageTimer timer(ws.stats, ScanStage::Thumbnail);
+                compute_thumbnail(frame, ws, analysis.thumb);
+                analysis.has_thumb = true;
+            }
+
+            if (reference && calculate_thumbnail_diff(reference->thumb, analysis.thumb) < coarse_threshold_)
+            {
+                analysis.is_static = true;
+                ws.stats.frames_static++;
+                return;
+            }
+        }
+
+        if constexpr (Metric::metric == ChangeMetric::PackedTiles)
+        {
+            // Fused edge stage: Canny -> pack -> 3x3 dilation on the packed rows -> mask
+            if (!analysis.has_packed)
+            {
+                const cv::Mat &input = prepare_input(frame, ws);
+
+                ScopedStageTimer timer(ws.stats, ScanStage::EdgeMap);
+                detect_edges(input, ws);
+                pack_edges(ws.edges, analysis.packed);
+                dilate_packed_edges(analysis.packed, ws.packed_rows);
+                if constexpr (Mask::masked)
+                    mask_excluded(analysis.packed, ws);
+                analysis.has_packed = true;
+            }
+
+            // COMPARE WITH REFERENCE, NOT WITH PREVIOUS FRAME (XOR + popcount on 1-bit maps)
+            ScopedStageTimer timer(ws.stats, ScanStage::ChangeMetric);
+            if (!reference)
+                return;
+            analysis.change_score = packed_tile_change_ratio(reference->packed, analysis.packed, ws.tile_counts);
+            if constexpr (Mask::masked)
+                analysis.change_score = normalize_to_coverage(analysis.change_score,
+                                                              cv::Size(analysis.packed.cols, analysis.packed.rows), ws);
+        }
+        else
+        {
+            // Get edge map of current frame
+            if (!analysis.has_edges)
+            {
+                const cv::Mat &input = prepare_input(frame, ws);
+
+                ScopedStageTimer timer(ws.stats, ScanStage::EdgeMap);
+                compute_edge_map(input, ws, analysis.edges);
+                if constexpr (Mask::masked)
+                    mask_excluded(analysis.edges, ws);
+                analysis.has_edges = true;
+            }
+
+            // COMPARE WITH REFERENCE, NOT WITH PREVIOUS FRAME
+            ScopedStageTimer timer(ws.stats, ScanStage::ChangeMetric);
+            if (!reference)
+                return;
+            double score = 1.0; // An empty map counts as a full change
+            if (!reference->edges.empty() && !analysis.edges.empty())
+            {
+                if constexpr (Metric::metric == ChangeMetric::Tiles)
+                {
+                    score = tile_change_ratio(reference->edges, analysis.edges, ws.tile_counts);
+                }
+                else
+                {
+                    cv::absdiff(reference->edges, analysis.edges, ws.diff);
+                    score = contour_change_ratio(ws.diff, ws);
+                }
+            }
+            if constexpr (Mask::masked)
+                score = normalize_to_coverage(score, analysis.edges.size(), ws);
+            analysis.change_score = score;
+        }
+    }
+
+    SlideDetector::AnalyzeKernel SlideDetector::select_analyze_kernel(const AnalysisRegion &region) const
+    {
+        if (compute_backend_ == ComputeBackend::OpenCL)
+            return &SlideDetector::analyze_frame_ocl;
+
+        return with_policies(change_metric_, coarse_threshold_ > 0.0, !region.exclude.empty(),
+                             [](auto metric, auto coarse, auto mask) -> AnalyzeKernel
+                             {
+                                 return &SlideDetector::analyze_frame_cpu<decltype(metric), decltype(coarse),
+                                                                          decltype(mask)>;
+                             });
+    }
+
+    std::string SlideDetector::get_analysis_kernel() const
+    {
+        if (compute_backend_ == ComputeBackend::OpenCL)
+            return "opencl";
+
+        return with_policies(change_metric_, coarse_threshold_ > 0.0, !region_.exclude.empty(),
+                             [](auto metric, auto coarse, auto mask)
+                             {
+                                 return std::string(decltype(metric)::name) + "/" + decltype(coarse)::name + "/" +
+                                        decltype(mask)::name;
+                             });
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,77 @@
+#include "ai_interview/slide_detector.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+// Memory budget of a scan (SlideDetector::set_memory_budget).
+//
+// The budget is split once: PIPELINE_MEMORY_SHARE bounds the decoded frames in flight
+// (scan_pipelined sizes its ring from it, scan_video the number of chunks), the rest bounds the
+// keyframes capture_slides (or a result cache hit) holds. Later keyframes are spilled to disk as
+// encoded images.
+
+namespace ai_interview
+{
+
+    size_t SlideDetector::frame_memory_budget() const
+    {
+        return static_cast<size_t>(static_cast<double>(memory_budget_) * PIPELINE_MEMORY_SHARE);
+    }
+
+    size_t SlideDetector::keyframe_memory_budget() const
+    {
+        if (memory_budget_ == 0)
+            return 0;
+        // Never 0 here: that would mean unlimited
+        return std::max<size_t>(1, memory_budget_ - frame_memory_budget());
+    }
+
+    void SlideDetector::spill_slide(CapturedSlide &slide, const std::string &encoding, const std::string &prefix) const
+    {
+        // Encoded mode: the bytes are written as they are. Raw mode: PNG, lossless, reads back unchanged.
+        const std::string extension = encoding.empty() ? ".png" : encoding;
+        if (slide.encoded.empty() && !cv::imencode(extension, slide.frame, slide.encoded))
+            throw std::runtime_error("Could not encode spilled slide as " + extension);
+
+        std::error_code ec;
+        const std::filesystem::path directory =
+            spill_dir_.empty() ? std::filesystem::temp_directory_path(ec) : std::filesystem::path(spill_dir_);
+        std::filesystem::create_directories(directory, ec);
+
+        const std::filesystem::path path =
+            directory / (prefix + std::to_string(slide.segment.frame_index) + extension);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char *>(slide.encoded.data()),
+                       static_cast<std::streamsize>(slide.encoded.size())))
+            throw std::runtime_error("Could not write spilled slide " + path.string());
+
+        slide.spill_path = path.string();
+        slide.frame.release();
+        slide.encoded.clear();
+        slide.encoded.shrink_to_fit();
+    }
+
+    void SlideDetector::budget_keyframe(CapturedSlide &slide, const std::string &encoding, const std::string &prefix,
+                                        size_t &held_bytes) const
+    {
+        const size_t keyframe_budget = keyframe_memory_budget();
+        if (keyframe_budget == 0)
+            return;
+
+        const size_t bytes = slide.encoded.empty() ? slide.frame.total() * slide.frame.elemSize() : slide.encoded.size();
+        if (held_bytes + bytes > keyframe_budget)
+            spill_slide(slide, encoding, prefix);
+        else
+            held_bytes += bytes;
+    }
+
+    std::string SlideDetector::make_spill_prefix()
+    {
+        return "slides-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "-" +
+               std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "-";
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,130 @@
+#include "ai_interview/slide_detector.hpp"
+#include <opencv2/core/ocl.hpp>
+
+// ComputeBackend::OpenCL version of SlideDetector::analyze_frame.
+//
+// Same stages as the CPU path, but on cv::UMat (OpenCV T-API): the decoded frame is uploaded
+// once, thumbnail / edge map / diff stay on the device and only scalars are read back.
+// Without an OpenCL device OpenCV runs the same calls on the CPU, so results don't depend
+// on whether a GPU is present. Kernels run asynchronously: a stage timer covers the enqueue,
+// the device time shows up in the stage that reads a result back (countNonZero, norm, download).
+
+namespace ai_interview
+{
+
+    bool SlideDetector::is_opencl_available()
+    {
+        return cv::ocl::haveOpenCL() && cv::ocl::useOpenCL();
+    }
+
+    void SlideDetector::analyze_frame_ocl(const cv::Mat &frame, const ReferencePtr &reference,
+                                          FrameAnalysis &analysis, Workspace &ws) const
+    {
+        analysis.reference = reference;
+        analysis.is_static = false;
+        analysis.change_score = 1.0;
+        ws.stats.frames_analyzed++;
+
+        // Upload only if a stage below actually needs the frame (thumb and edges may already be there)
+        // Re-scores (pipeline decision stage) upload nothing: the workspace may never have held a frame
+        const bool need_thumb = coarse_threshold_ > 0.0 && !analysis.has_thumb;
+        cv::UMat u_input;
+        if (need_thumb || !analysis.has_edges)
+        {
+            frame.copyTo(ws.u_frame);
+            // Include area of the uploaded frame (a view)
+            u_input = ws.region.is_full_frame() ? ws.u_frame
+                                                : ws.u_frame(region_to_pixels(ws.region.include, frame.size()));
+        }
+
+        // Coarse stage: 64x36 thumbnail, mean absolute difference with the reference
+        if (coarse_threshold_ > 0.0)
+        {
+            if (need_thumb)
+            {
+                ScopedStageTimer timer(ws.stats, ScanStage::Thumbnail);
+                if (u_input.channels() == 1)
+                {
+                    cv::resize(u_input, analysis.u_thumb, cv::Size(COARSE_THUMB_WIDTH, COARSE_THUMB_HEIGHT), 0, 0,
+                               cv::INTER_AREA);
+                }
+                else
+                {
+                    cv::resize(u_input, ws.u_small, cv::Size(COARSE_THUMB_WIDTH, COARSE_THUMB_HEIGHT), 0, 0,
+                               cv::INTER_AREA);
+                    cv::cvtColor(ws.u_small, analysis.u_thumb, cv::COLOR_BGR2GRAY);
+                }
+                mask_excluded(analysis.u_thumb, ws);
+                analysis.has_thumb = true;
+            }
+
+            if (reference && !reference->u_thumb.empty())
+            {
+                double diff = cv::norm(reference->u_thumb, analysis.u_thumb, cv::NORM_L1) /
+                              static_cast<double>(analysis.u_thumb.total());
+                if (diff < coarse_threshold_)
+                {
+                    analysis.is_static = true;
+                    ws.stats.frames_static++;
+                    return;
+                }
+            }
+        }
+
+        // Edge map: resize -> gray -> blur -> Canny -> dilate, all on the device
+        if (!analysis.has_edges)
+        {
+            // Scale of the whole frame, like the CPU path
+            const cv::UMat *input = &u_input;
+            if (frame.cols > DEFAULT_RESIZE_WIDTH)
+            {
+                ScopedStageTimer timer(ws.stats, ScanStage::Resize);
+                double scale = static_cast<double>(DEFAULT_RESIZE_WIDTH) / frame.cols;
+                cv::resize(u_input, ws.u_resized, cv::Size(), scale, scale);
+                input = &ws.u_resized;
+            }
+
+            ScopedStageTimer timer(ws.stats, ScanStage::EdgeMap);
+            const cv::UMat *gray = input;
+            if (input->channels() != 1)
+            {
+                cv::cvtColor(*input, ws.u_gray, cv::COLOR_BGR2GRAY);
+                gray = &ws.u_gray;
+            }
+
+            cv::GaussianBlur(*gray, ws.u_blurred, cv::Size(GAUSSIAN_BLUR_SIZE, GAUSSIAN_BLUR_SIZE), 0);
+            cv::Canny(ws.u_blurred, ws.u_edges, CANNY_THRESHOLD_LOW, CANNY_THRESHOLD_HIGH);
+            cv::dilate(ws.u_edges, analysis.u_edges, dilation_kernel_);
+            mask_excluded(analysis.u_edges, ws);
+            analysis.has_edges = true;
+        }
+
+        if (!reference || reference->u_edges.empty())
+            return;
+
+        // COMPARE WITH REFERENCE, NOT WITH PREVIOUS FRAME
+        ScopedStageTimer timer(ws.stats, ScanStage::ChangeMetric);
+        cv::absdiff(reference->u_edges, analysis.u_edges, ws.u_diff);
+
+        if (change_metric_ == ChangeMetric::Contours)
+        {
+            // findContours has no OpenCL kernel: download the (binary) diff only
+            ws.u_diff.copyTo(ws.diff);
+            analysis.change_score = normalize_to_coverage(contour_change_ratio(ws.diff, ws), ws.diff.size(), ws);
+            return;
+        }
+
+        // Tiles / PackedTiles: INTER_AREA averages every tile, so a tile is dirty when its mean is at
+        // least CHANGE_TILE_MIN_PIXELS * 255 / tile area (the mean is rounded to 8 bits, hence -0.5).
+        // Exact when the size is a multiple of CHANGE_TILE_SIZE; border tiles are approximated otherwise.
+        const int tiles_x = (ws.u_diff.cols + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        const int tiles_y = (ws.u_diff.rows + CHANGE_TILE_SIZE - 1) / CHANGE_TILE_SIZE;
+        cv::resize(ws.u_diff, ws.u_tiles, cv::Size(tiles_x, tiles_y), 0, 0, cv::INTER_AREA);
+        cv::threshold(ws.u_tiles, ws.u_tiles,
+                      CHANGE_TILE_MIN_PIXELS * 255.0 / (CHANGE_TILE_SIZE * CHANGE_TILE_SIZE) - 0.5, 255,
+                      cv::THRESH_BINARY);
+        analysis.change_score = normalize_to_coverage(
+            static_cast<double>(cv::countNonZero(ws.u_tiles)) / (tiles_x * tiles_y), ws.u_diff.size(), ws);
+    }
+
+} // namespace ai_interview
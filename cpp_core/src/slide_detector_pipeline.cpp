@@ -0,0 +1,275 @@
+#include "ai_interview/slide_detector.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Pipelined implementation of SlideDetector::scan_video.
+//
+//   decoder thread  --(ring buffer of preallocated frames)-->  N analysis workers
+//                                                                      |
+//   calling thread: in-order decision stage  <-------------------------+
+//
+// Workers compute thumbnails, edge maps and change scores against the reference that was
+// current when they picked the frame up. The decision stage consumes frames strictly in
+// order; if a slide was emitted while a frame was in flight, that frame is re-scored against
+// the new reference (reusing its edge map). So the result is identical to scan_serial.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        // Frames in flight per analysis worker (bounds memory: slots * one decoded frame)
+        constexpr int PIPELINE_SLOTS_PER_WORKER = 2;
+
+        enum class SlotState
+        {
+            Free,      // Owned by the decoder
+            Decoded,   // Waiting in the work queue
+            Analyzing, // Owned by a worker
+            Analyzed   // Waiting for the decision stage
+        };
+    } // namespace
+
+    std::vector<SlideSegment> SlideDetector::scan_pipelined(cv::VideoCapture &cap, double fps, int num_threads,
+                                                            const AnalysisRegion &region,
+                                                            const SlideCallback &on_slide, ScanStats *stats,
+                                                            ScanReporter *reporter) const
+    {
+        struct Slot
+        {
+            cv::Mat frame;          // Decoded BGR frame, buffer reused between frames
+            FrameAnalysis analysis; // Its buffers are reused between frames as well
+            SlotState state = SlotState::Free;
+            long long seq = -1;
+            int frame_idx = 0;
+            double timestamp = 0.0;
+        };
+
+        const int stride = effective_stride(fps);
+        int num_workers = std::max(1, num_threads - 1); // One thread is the decoder
+        int num_slots = num_workers * PIPELINE_SLOTS_PER_WORKER + 2;
+        const int frame_width = (int)cap.get(cv::CAP_PROP_FRAME_WIDTH);
+        const int frame_height = (int)cap.get(cv::CAP_PROP_FRAME_HEIGHT);
+
+        // Memory budget: fewer frames in flight, and no more workers than they can keep busy
+        if (frame_memory_budget() > 0 && frame_width > 0 && frame_height > 0)
+        {
+            const size_t slot_bytes = static_cast<size_t>(frame_width) * frame_height * 3;
+            const size_t affordable = frame_memory_budget() / slot_bytes;
+            num_slots = static_cast<int>(std::clamp<size_t>(affordable, MIN_PIPELINE_SLOTS, num_slots));
+            num_workers = std::min(num_workers, num_slots - 1);
+        }
+
+        // Preallocate the ring so retrieve() writes into existing buffers
+        std::vector<Slot> slots(num_slots);
+        if (frame_width > 0 && frame_height > 0)
+        {
+            for (auto &slot : slots)
+                slot.frame.create(frame_height, frame_width, CV_8UC3);
+        }
+
+        // Everything below is protected by `mutex`
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<int> work_queue; // Slot ids in Decoded state
+        bool decode_done = false;
+        long long total_frames = 0; // Valid once decode_done
+        bool abort = false;
+        std::exception_ptr error;
+
+        DetectionState state = make_detection_state(region);
+        ScanStats decode_stats;                 // Decoder thread only
+        ScanStats worker_stats;                 // Workers add theirs when they exit
+        Workspace decision_ws;                  // Decision stage (calling thread)
+        decision_ws.region = state.region;
+        ReferencePtr shared_reference;          // Copy of state.reference for the workers
+        double shared_last_slide_time = state.last_slide_time;
+
+        auto fail = [&](std::exception_ptr e)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = e;
+            abort = true;
+            cond.notify_all();
+        };
+
+        auto decoder = [&]()
+        {
+            try
+            {
+                long long seq = 0;
+                for (int frame_idx = 0; timed_grab(cap, decode_stats); frame_idx++)
+                {
+                    if (reporter)
+                        reporter->frame_decoded();
+
+                    if (frame_idx % stride != 0)
+                    {
+                        decode_stats.frames_skipped++;
+                        continue;
+                    }
+
+                    double timestamp = frame_idx / fps;
+                    Slot *slot = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        // Same early skip as the serial loop. The decision stage may already have moved
+                        // last_slide_time further, so this only ever skips frames the serial loop skips too.
+                        if (shared_reference && (timestamp - shared_last_slide_time) < min_duration_)
+                        {
+                            decode_stats.frames_skipped++;
+                            continue;
+                        }
+
+                        slot = &slots[seq % num_slots];
+                        cond.wait(lock, [&]
+                                  { return abort || slot->state == SlotState::Free; });
+                        if (abort)
+                            return;
+                    }
+
+                    // The slot is Free, so only this thread touches it
+                    if (!timed_retrieve(cap, slot->frame, decode_stats))
+                        break;
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot->seq = seq;
+                    slot->frame_idx = frame_idx;
+                    slot->timestamp = timestamp;
+                    slot->state = SlotState::Decoded;
+                    work_queue.push_back(static_cast<int>(seq % num_slots));
+                    seq++;
+                    cond.notify_all();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                total_frames = seq;
+                decode_done = true;
+                cond.notify_all();
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        };
+
+        auto worker = [&]()
+        {
+            try
+            {
+                Workspace ws; // Per-thread scratch buffers
+                ws.region = state.region;
+                for (;;)
+                {
+                    Slot *slot = nullptr;
+                    ReferencePtr reference;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cond.wait(lock, [&]
+                                  { return abort || !work_queue.empty() || decode_done; });
+                        if (abort || work_queue.empty())
+                        {
+                            worker_stats.merge(ws.stats);
+                            return;
+                        }
+
+                        slot = &slots[work_queue.front()];
+                        work_queue.pop_front();
+                        slot->state = SlotState::Analyzing;
+                        reference = shared_reference;
+                    }
+
+                    slot->analysis.reset();
+                    analyze_frame(slot->frame, reference, slot->analysis, ws);
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot->state = SlotState::Analyzed;
+                    cond.notify_all();
+                }
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_workers + 1);
+
+        // Threads capture locals by reference: they must be joined before leaving this scope
+        auto stop_and_join = [&]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                abort = true;
+                cond.notify_all();
+            }
+            for (auto &t : threads)
+            {
+                if (t.joinable())
+                    t.join();
+            }
+        };
+
+        try
+        {
+            threads.emplace_back(decoder);
+            for (int i = 0; i < num_workers; i++)
+                threads.emplace_back(worker);
+
+            // In-order decision stage (calling thread)
+            for (long long next = 0;; next++)
+            {
+                Slot &slot = slots[next % num_slots];
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [&]
+                              { return abort || (slot.state == SlotState::Analyzed && slot.seq == next) ||
+                                       (decode_done && next >= total_frames); });
+                    if (abort || slot.state != SlotState::Analyzed || slot.seq != next)
+                        break;
+                }
+
+                // A slide was emitted while this frame was in flight: re-score against the current reference
+                if (slot.analysis.reference != state.reference)
+                    analyze_frame(slot.frame, state.reference, slot.analysis, decision_ws);
+
+                bool emitted = apply_decision(state, slot.frame_idx, slot.timestamp, slot.analysis);
+                if (emitted && on_slide)
+                    on_slide(state.segments.back(), slot.frame);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (emitted)
+                {
+                    shared_reference = state.reference;
+                    shared_last_slide_time = state.last_slide_time;
+                }
+                slot.state = SlotState::Free;
+                cond.notify_all();
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+
+        stop_and_join();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        if (stats)
+        {
+            stats->merge(decode_stats);
+            stats->merge(worker_stats);
+            stats->merge(decision_ws.stats);
+        }
+        return std::move(state.segments);
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,83 @@
+#include "ai_interview/slide_detector.hpp"
+
+// Early results of process_video / process_video_with_frames (ScanObserver).
+//
+// Frames are counted by whichever thread decodes them (the serial loop, the pipeline decoder or
+// every chunk thread), so the counter is an atomic. The observer callbacks go through one
+// mutex: progress comes from the decoder threads, slides from the decision stage.
+// The resident set size is sampled at the same points (and for every slide), observer or not.
+
+namespace ai_interview
+{
+
+    SlideDetector::ScanReporter::ScanReporter(const ScanObserver &observer)
+        : observer_(observer),
+          next_report_(std::chrono::steady_clock::now())
+    {
+        sample_memory();
+    }
+
+    void SlideDetector::ScanReporter::frame_decoded()
+    {
+        const int frames = frames_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (frames % PROGRESS_CHECK_FRAMES != 0)
+            return;
+        sample_memory();
+        if (!observer_.on_progress)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (now < next_report_)
+            return;
+        next_report_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                 std::chrono::duration<double>(observer_.progress_interval_sec));
+
+        ScanProgress progress;
+        progress.frames_processed = frames;
+        progress.total_frames = total_frames_;
+        observer_.on_progress(progress);
+    }
+
+    void SlideDetector::ScanReporter::sample_memory()
+    {
+        const uint64_t rss = current_rss_bytes();
+        uint64_t peak = peak_rss_.load(std::memory_order_relaxed);
+        while (rss > peak && !peak_rss_.compare_exchange_weak(peak, rss, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void SlideDetector::ScanReporter::segment(const SlideSegment &segment)
+    {
+        if (!observer_.on_segment)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        observer_.on_segment(segment);
+    }
+
+    void SlideDetector::ScanReporter::slide(const CapturedSlide &slide)
+    {
+        sample_memory(); // Keyframes are what grows over a scan
+        if (!wants_segments())
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (observer_.on_segment)
+            observer_.on_segment(slide.segment);
+        if (observer_.on_slide)
+            observer_.on_slide(slide);
+    }
+
+    void SlideDetector::ScanReporter::finish()
+    {
+        if (!observer_.on_progress)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        ScanProgress progress;
+        progress.frames_processed = frames_.load(std::memory_order_relaxed);
+        progress.total_frames = total_frames_;
+        progress.done = true;
+        observer_.on_progress(progress);
+    }
+
+} // namespace ai_interview
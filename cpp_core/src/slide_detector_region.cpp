@@ -0,0 +1,218 @@
+#include "ai_interview/slide_detector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Region of interest of SlideDetector: include / exclude rectangles and the automatic
+// detection of a persistent high-motion overlay (picture-in-picture webcam).
+//
+// Rectangles are stored as fractions of the frame, the pixel rectangles are derived per image:
+// the include area crops the frame, exclude areas are blanked in images of the include area.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        bool is_valid_region(const cv::Rect2d &region)
+        {
+            constexpr double EPS = 1e-9;
+            return region.width > 0.0 && region.height > 0.0 && region.x >= 0.0 && region.y >= 0.0 &&
+                   region.x + region.width <= 1.0 + EPS && region.y + region.height <= 1.0 + EPS;
+        }
+
+        // Exclude regions in pixels of an image of `size` showing the include area (empty ones dropped)
+        void exclude_to_pixels(const AnalysisRegion &region, cv::Size size, std::vector<cv::Rect> &rects)
+        {
+            rects.clear();
+            const cv::Rect2d &inc = region.include;
+            for (const auto &r : region.exclude)
+            {
+                // Relative to the include area, clipped to it
+                const double x0 = std::max(0.0, (r.x - inc.x) / inc.width);
+                const double y0 = std::max(0.0, (r.y - inc.y) / inc.height);
+                const double x1 = std::min(1.0, (r.x + r.width - inc.x) / inc.width);
+                const double y1 = std::min(1.0, (r.y + r.height - inc.y) / inc.height);
+                if (x1 <= x0 || y1 <= y0)
+                    continue;
+
+                // Rounded outwards: a partially covered pixel is excluded
+                const int px0 = static_cast<int>(std::floor(x0 * size.width));
+                const int py0 = static_cast<int>(std::floor(y0 * size.height));
+                const int px1 = std::min(size.width, static_cast<int>(std::ceil(x1 * size.width)));
+                const int py1 = std::min(size.height, static_cast<int>(std::ceil(y1 * size.height)));
+                if (px1 > px0 && py1 > py0)
+                    rects.emplace_back(px0, py0, px1 - px0, py1 - py0);
+            }
+        }
+    } // namespace
+
+    void SlideDetector::set_include_region(const cv::Rect2d &region)
+    {
+        if (!is_valid_region(region))
+            throw std::invalid_argument("Include region must be a non-empty rectangle inside 0.0 - 1.0");
+        region_.include = region;
+    }
+
+    void SlideDetector::add_exclude_region(const cv::Rect2d &region)
+    {
+        if (!is_valid_region(region))
+            throw std::invalid_argument("Exclude region must be a non-empty rectangle inside 0.0 - 1.0");
+        region_.exclude.push_back(region);
+    }
+
+    void SlideDetector::set_auto_exclude_duration(double seconds)
+    {
+        if (seconds < 0.0)
+            throw std::invalid_argument("Auto exclude duration must be >= 0");
+        auto_exclude_sec_ = seconds;
+    }
+
+    cv::Rect SlideDetector::region_to_pixels(const cv::Rect2d &region, cv::Size size)
+    {
+        const int x0 = std::clamp(static_cast<int>(std::floor(region.x * size.width)), 0, size.width - 1);
+        const int y0 = std::clamp(static_cast<int>(std::floor(region.y * size.height)), 0, size.height - 1);
+        const int x1 = std::clamp(static_cast<int>(std::ceil((region.x + region.width) * size.width)), x0 + 1, size.width);
+        const int y1 = std::clamp(static_cast<int>(std::ceil((region.y + region.height) * size.height)), y0 + 1, size.height);
+        return cv::Rect(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    void SlideDetector::mask_excluded(cv::Mat &image, Workspace &ws) const
+    {
+        if (ws.region.exclude.empty())
+            return;
+        exclude_to_pixels(ws.region, image.size(), ws.exclude_rects);
+        for (const auto &rect : ws.exclude_rects)
+            image(rect).setTo(cv::Scalar(0));
+    }
+
+    void SlideDetector::mask_excluded(cv::UMat &image, Workspace &ws) const
+    {
+        if (ws.region.exclude.empty())
+            return;
+        exclude_to_pixels(ws.region, image.size(), ws.exclude_rects);
+        for (const auto &rect : ws.exclude_rects)
+            image(rect).setTo(cv::Scalar(0));
+    }
+
+    void SlideDetector::mask_excluded(PackedEdges &edges, Workspace &ws) const
+    {
+        if (ws.region.exclude.empty())
+            return;
+        exclude_to_pixels(ws.region, cv::Size(edges.cols, edges.rows), ws.exclude_rects);
+        for (const auto &rect : ws.exclude_rects)
+            clear_packed_rect(edges, rect);
+    }
+
+    double SlideDetector::normalize_to_coverage(double score, cv::Size size, Workspace &ws) const
+    {
+        if (ws.region.exclude.empty())
+            return score;
+
+        // Exclude rectangles may overlap: measure their union once per image size
+        if (size != ws.coverage_size)
+        {
+            cv::Mat excluded(size, CV_8UC1, cv::Scalar(0));
+            exclude_to_pixels(ws.region, size, ws.exclude_rects);
+            for (const auto &rect : ws.exclude_rects)
+                excluded(rect).setTo(cv::Scalar(255));
+            ws.coverage = 1.0 - static_cast<double>(cv::countNonZero(excluded)) / size.area();
+            ws.coverage_size = size;
+        }
+
+        if (ws.coverage <= 0.0)
+            return 0.0; // Nothing left to analyze
+        return std::min(1.0, score / ws.coverage);
+    }
+
+    AnalysisRegion SlideDetector::detect_analysis_region(const VideoSource &video) const
+    {
+        AnalysisRegion region = region_;
+        if (auto_exclude_sec_ <= 0.0)
+            return region;
+
+        cv::VideoCapture cap;
+        open_capture(cap, video);
+        const double fps = cap.get(cv::CAP_PROP_FPS);
+        if (fps <= 0.0)
+            return region;
+
+        const int stride = std::max(1, static_cast<int>(std::lround(fps / AUTO_REGION_SAMPLE_FPS)));
+        const int end_frame = static_cast<int>(std::lround(auto_exclude_sec_ * fps));
+        const cv::Size grid_size(AUTO_REGION_GRID_WIDTH, AUTO_REGION_GRID_HEIGHT);
+
+        // How often every grid cell changed between consecutive samples.
+        // Slides stay still for seconds, a talking head never does.
+        std::vector<int> moves(static_cast<size_t>(grid_size.area()), 0);
+        int pairs = 0;
+
+        cv::Mat frame, small, grid, previous, diff;
+        for (int frame_idx = 0; frame_idx < end_frame && cap.grab(); frame_idx++)
+        {
+            if (frame_idx % stride != 0)
+                continue;
+            if (!cap.retrieve(frame))
+                break;
+
+            if (frame.channels() == 1)
+            {
+                cv::resize(frame, grid, grid_size, 0, 0, cv::INTER_AREA);
+            }
+            else
+            {
+                cv::resize(frame, small, grid_size, 0, 0, cv::INTER_AREA);
+                cv::cvtColor(small, grid, cv::COLOR_BGR2GRAY);
+            }
+
+            if (!previous.empty())
+            {
+                cv::absdiff(grid, previous, diff);
+                for (int y = 0; y < grid_size.height; y++)
+                {
+                    const uchar *row = diff.ptr<uchar>(y);
+                    for (int x = 0; x < grid_size.width; x++)
+                    {
+                        if (row[x] > AUTO_REGION_MOTION_LEVEL)
+                            moves[static_cast<size_t>(y) * grid_size.width + x]++;
+                    }
+                }
+                pairs++;
+            }
+            std::swap(grid, previous);
+        }
+        cap.release();
+
+        if (pairs < 2)
+            return region;
+
+        // Cells that keep moving, merged into blobs (the dilation also pads every blob by one cell)
+        cv::Mat moving(grid_size, CV_8UC1, cv::Scalar(0));
+        const int min_moves = std::max(1, static_cast<int>(std::ceil(AUTO_REGION_MIN_SHARE * pairs)));
+        for (int y = 0; y < grid_size.height; y++)
+        {
+            uchar *row = moving.ptr<uchar>(y);
+            for (int x = 0; x < grid_size.width; x++)
+                row[x] = moves[static_cast<size_t>(y) * grid_size.width + x] >= min_moves ? 255 : 0;
+        }
+        cv::dilate(moving, moving, dilation_kernel_);
+
+        cv::Mat labels, stats, centroids;
+        const int num_labels = cv::connectedComponentsWithStats(moving, labels, stats, centroids);
+        for (int label = 1; label < num_labels; label++)
+        {
+            const int *s = stats.ptr<int>(label);
+            const cv::Rect box(s[cv::CC_STAT_LEFT], s[cv::CC_STAT_TOP], s[cv::CC_STAT_WIDTH], s[cv::CC_STAT_HEIGHT]);
+            if (s[cv::CC_STAT_AREA] < AUTO_REGION_MIN_CELLS || box.area() > AUTO_REGION_MAX_AREA * grid_size.area())
+                continue;
+
+            const cv::Rect2d overlay(static_cast<double>(box.x) / grid_size.width,
+                                     static_cast<double>(box.y) / grid_size.height,
+                                     static_cast<double>(box.width) / grid_size.width,
+                                     static_cast<double>(box.height) / grid_size.height);
+            if ((overlay & region.include).area() > 0.0)
+                region.exclude.push_back(overlay);
+        }
+        return region;
+    }
+
+} // namespace ai_interview
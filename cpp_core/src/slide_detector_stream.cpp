@@ -0,0 +1,67 @@
+#include "ai_interview/slide_detector.hpp"
+#include <stdexcept>
+
+// Streaming API of SlideDetector: the same analyze_frame / apply_decision stages as
+// process_video, but the DetectionState lives between calls instead of in a local loop.
+
+namespace ai_interview
+{
+
+    void SlideDetector::begin()
+    {
+        stream_ = std::make_unique<StreamState>();
+        stream_->detection = make_detection_state(region_);
+        stream_->workspace.region = region_; // Configured regions only: no auto-detection on a stream
+    }
+
+    std::vector<SlideSegment> SlideDetector::push_frame(const cv::Mat &frame, double timestamp_sec)
+    {
+        if (!stream_)
+            throw std::logic_error("push_frame called before begin()");
+        if (frame.empty())
+            throw std::invalid_argument("push_frame: empty frame");
+
+        StreamState &stream = *stream_;
+        if (stream.next_frame_index > 0 && timestamp_sec < stream.last_timestamp)
+            throw std::invalid_argument("push_frame: timestamps must not decrease");
+
+        const int frame_idx = stream.next_frame_index++;
+        stream.last_timestamp = timestamp_sec;
+        DetectionState &state = stream.detection;
+
+        // Sampling: by timestamp when a target FPS is set (the stream FPS is unknown), otherwise by stride
+        if (target_analysis_fps_ > 0.0)
+        {
+            if (timestamp_sec < stream.next_analysis_time)
+                return {};
+            stream.next_analysis_time = timestamp_sec + 1.0 / target_analysis_fps_;
+        }
+        else if (frame_idx % frame_stride_ != 0)
+        {
+            return {};
+        }
+
+        // A new slide can't be emitted before min_duration has passed
+        if (state.reference && (timestamp_sec - state.last_slide_time) < min_duration_)
+            return {};
+
+        stream.analysis.reset();
+        analyze_frame(frame, state.reference, stream.analysis, stream.workspace);
+
+        if (!apply_decision(state, frame_idx, timestamp_sec, stream.analysis))
+            return {};
+
+        return {state.segments.back()};
+    }
+
+    std::vector<SlideSegment> SlideDetector::finish()
+    {
+        if (!stream_)
+            throw std::logic_error("finish called before begin()");
+
+        std::vector<SlideSegment> segments = std::move(stream_->detection.segments);
+        stream_.reset();
+        return segments;
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,207 @@
+#include "ai_interview/slide_detector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Slide crop and text regions for OCR (SlideDetector::extract_text_regions).
+//
+// Everything is found on the edge map of the detection stage, at the analysis scale:
+//   1. slide outline: largest convex quadrilateral contour, if nearly all edges lie inside it;
+//      otherwise the bounding box of all edges
+//   2. the edge map is rectified (or cropped) like the slide
+//   3. a closing joins letters into lines and lines into blocks; dense blocks are text
+// Only the final crops are taken from the full-resolution frame.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        // Corners sorted as top-left, top-right, bottom-right, bottom-left
+        std::vector<cv::Point2f> order_corners(const std::vector<cv::Point> &quad)
+        {
+            std::vector<cv::Point2f> corners(4);
+            auto by_sum = [](const cv::Point &a, const cv::Point &b)
+            { return a.x + a.y < b.x + b.y; };
+            auto by_diff = [](const cv::Point &a, const cv::Point &b)
+            { return a.y - a.x < b.y - b.x; };
+            corners[0] = *std::min_element(quad.begin(), quad.end(), by_sum);
+            corners[2] = *std::max_element(quad.begin(), quad.end(), by_sum);
+            corners[1] = *std::min_element(quad.begin(), quad.end(), by_diff);
+            corners[3] = *std::max_element(quad.begin(), quad.end(), by_diff);
+            return corners;
+        }
+
+        // Slide outline seen as a quadrilateral (projector or screen filmed at an angle)
+        bool find_outline(const cv::Mat &edges, std::vector<cv::Point2f> &corners)
+        {
+            const int total_edges = cv::countNonZero(edges);
+            if (total_edges == 0)
+                return false;
+
+            std::vector<std::vector<cv::Point>> contours;
+            cv::findContours(edges, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+            const double min_area = SLIDE_OUTLINE_MIN_AREA * static_cast<double>(edges.total());
+            double best_area = 0.0;
+            std::vector<cv::Point> best;
+            std::vector<cv::Point> poly;
+            for (const auto &contour : contours)
+            {
+                cv::approxPolyDP(contour, poly, SLIDE_OUTLINE_APPROX * cv::arcLength(contour, true), true);
+                if (poly.size() != 4 || !cv::isContourConvex(poly))
+                    continue;
+                const double area = std::fabs(cv::contourArea(poly));
+                if (area >= min_area && area > best_area)
+                {
+                    best_area = area;
+                    best = poly;
+                }
+            }
+            if (best.empty())
+                return false;
+
+            // A box drawn on the slide (table, picture frame) leaves the title etc. outside
+            cv::Mat outside = edges.clone();
+            cv::fillConvexPoly(outside, best, cv::Scalar(0));
+            if (cv::countNonZero(outside) > SLIDE_OUTLINE_MAX_OUTSIDE * total_edges)
+                return false;
+
+            corners = order_corners(best);
+            return true;
+        }
+
+        double distance(const cv::Point2f &a, const cv::Point2f &b)
+        {
+            return std::hypot(a.x - b.x, a.y - b.y);
+        }
+
+        // Dark text on white whatever the slide theme: the background is the larger Otsu class
+        cv::Mat binarize(const cv::Mat &image)
+        {
+            cv::Mat gray;
+            if (image.channels() == 1)
+                gray = image;
+            else
+                cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+
+            cv::Mat binary;
+            cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+            if (cv::countNonZero(binary) < static_cast<int>(binary.total() / 2))
+                cv::bitwise_not(binary, binary);
+            return binary;
+        }
+    } // namespace
+
+    SlideCrop SlideDetector::extract_text_regions(const cv::Mat &frame, const TextRegionOptions &options) const
+    {
+        return extract_text_regions(frame, options, region_);
+    }
+
+    SlideCrop SlideDetector::extract_text_regions(const cv::Mat &frame, const TextRegionOptions &options,
+                                                  const AnalysisRegion &region) const
+    {
+        if (frame.empty())
+            throw std::invalid_argument("extract_text_regions: empty frame");
+        if (options.padding < 0)
+            throw std::invalid_argument("Text region padding must be >= 0");
+
+        // 1. Edge map exactly as the scan computes it
+        Workspace ws;
+        ws.region = region;
+        cv::Mat edges;
+        compute_edge_map(prepare_input(frame, ws), ws, edges);
+        mask_excluded(edges, ws);
+
+        // Analysis pixels -> frame pixels
+        const cv::Rect include = region_to_pixels(region.include, frame.size());
+        const double sx = static_cast<double>(include.width) / edges.cols;
+        const double sy = static_cast<double>(include.height) / edges.rows;
+        auto to_frame = [&](const cv::Point2f &p)
+        { return cv::Point2f(static_cast<float>(p.x * sx + include.x), static_cast<float>(p.y * sy + include.y)); };
+
+        SlideCrop crop;
+        cv::Mat slide_edges;
+        std::vector<cv::Point2f> outline;
+        const bool has_outline = find_outline(edges, outline);
+
+        // 2. Slide alone, and its edges in the same geometry
+        if (has_outline && options.deskew)
+        {
+            const int width = std::max(1, cvRound(std::max(distance(outline[0], outline[1]), distance(outline[3], outline[2]))));
+            const int height = std::max(1, cvRound(std::max(distance(outline[0], outline[3]), distance(outline[1], outline[2]))));
+            const std::vector<cv::Point2f> target = {
+                {0.0f, 0.0f}, {width - 1.0f, 0.0f}, {width - 1.0f, height - 1.0f}, {0.0f, height - 1.0f}};
+            cv::warpPerspective(edges, slide_edges, cv::getPerspectiveTransform(outline, target),
+                                cv::Size(width, height), cv::INTER_NEAREST);
+
+            const cv::Size full_size(std::max(1, cvRound(width * sx)), std::max(1, cvRound(height * sy)));
+            const std::vector<cv::Point2f> full_target = {
+                {0.0f, 0.0f},
+                {full_size.width - 1.0f, 0.0f},
+                {full_size.width - 1.0f, full_size.height - 1.0f},
+                {0.0f, full_size.height - 1.0f}};
+            for (const auto &p : outline)
+                crop.corners.push_back(to_frame(p));
+            cv::warpPerspective(frame, crop.slide, cv::getPerspectiveTransform(crop.corners, full_target), full_size,
+                                cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+            crop.deskewed = true;
+        }
+        else
+        {
+            cv::Rect box(0, 0, edges.cols, edges.rows); // Blank slide: keep the whole analyzed area
+            if (has_outline)
+                box = cv::boundingRect(outline) & box;
+            else if (cv::countNonZero(edges) > 0)
+                box = cv::boundingRect(edges);
+            slide_edges = edges(box);
+
+            const cv::Rect full_box = cv::Rect(cvFloor(box.x * sx) + include.x, cvFloor(box.y * sy) + include.y,
+                                               cvCeil(box.width * sx), cvCeil(box.height * sy)) &
+                                      cv::Rect(0, 0, frame.cols, frame.rows);
+            crop.slide = frame(full_box).clone();
+            crop.corners = {to_frame(cv::Point2f(static_cast<float>(box.x), static_cast<float>(box.y))),
+                            to_frame(cv::Point2f(static_cast<float>(box.br().x), static_cast<float>(box.y))),
+                            to_frame(cv::Point2f(static_cast<float>(box.br().x), static_cast<float>(box.br().y))),
+                            to_frame(cv::Point2f(static_cast<float>(box.x), static_cast<float>(box.br().y)))};
+        }
+
+        // 3. Dense blocks of joined edges
+        cv::Mat joined;
+        const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(TEXT_JOIN_KERNEL_WIDTH, TEXT_JOIN_KERNEL_HEIGHT));
+        cv::morphologyEx(slide_edges, joined, cv::MORPH_CLOSE, kernel);
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(joined, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+        const double fx = static_cast<double>(crop.slide.cols) / slide_edges.cols;
+        const double fy = static_cast<double>(crop.slide.rows) / slide_edges.rows;
+        const cv::Rect slide_rect(0, 0, crop.slide.cols, crop.slide.rows);
+        for (const auto &contour : contours)
+        {
+            const cv::Rect block = cv::boundingRect(contour);
+            if (block.height < TEXT_MIN_BLOCK_HEIGHT)
+                continue;
+            const double density = static_cast<double>(cv::countNonZero(slide_edges(block))) / block.area();
+            if (density < TEXT_MIN_EDGE_DENSITY)
+                continue;
+
+            TextRegion text;
+            text.rect = cv::Rect(cvFloor(block.x * fx) - options.padding, cvFloor(block.y * fy) - options.padding,
+                                 cvCeil(block.width * fx) + 2 * options.padding,
+                                 cvCeil(block.height * fy) + 2 * options.padding) &
+                        slide_rect;
+            if (!text.rect.empty())
+                crop.regions.push_back(std::move(text));
+        }
+
+        // Reading order
+        std::sort(crop.regions.begin(), crop.regions.end(), [](const TextRegion &a, const TextRegion &b)
+                  { return a.rect.y != b.rect.y ? a.rect.y < b.rect.y : a.rect.x < b.rect.x; });
+
+        // Own copies: a region must not keep the whole slide alive
+        for (auto &text : crop.regions)
+            text.image = options.binarize ? binarize(crop.slide(text.rect)) : crop.slide(text.rect).clone();
+        return crop;
+    }
+
+} // namespace ai_interview
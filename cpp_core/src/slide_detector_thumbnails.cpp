@@ -0,0 +1,185 @@
+#include "ai_interview/slide_detector.hpp"
+#include "ai_interview/thread_pool.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+// Slide previews (SlideDetector::make_thumbnails).
+//
+// The calling thread only decodes (visit_frames). Every decoded frame goes to the pool, which
+// downscales it, encodes it and writes it out; the full-resolution frame is released as soon as
+// its thumbnail exists. The decoder waits while every worker has a frame, so at most pool size
+// frames are alive. The sprite sheet is assembled from the kept thumbnails at the end.
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        std::vector<int> encode_params(const ThumbnailOptions &options)
+        {
+            if (options.encoding == ".jpg" || options.encoding == ".jpeg")
+                return {cv::IMWRITE_JPEG_QUALITY, options.quality};
+            if (options.encoding == ".webp")
+                return {cv::IMWRITE_WEBP_QUALITY, options.quality};
+            return {};
+        }
+
+        std::vector<uchar> encode(const cv::Mat &image, const ThumbnailOptions &options, const std::vector<int> &params)
+        {
+            std::vector<uchar> encoded;
+            if (!cv::imencode(options.encoding, image, encoded, params))
+                throw std::runtime_error("Could not encode thumbnail as " + options.encoding);
+            return encoded;
+        }
+
+        // Writes the bytes to the file instead of returning them
+        std::string write_file(const std::filesystem::path &path, std::vector<uchar> &encoded)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out.write(reinterpret_cast<const char *>(encoded.data()), static_cast<std::streamsize>(encoded.size())))
+                throw std::runtime_error("Could not write thumbnail " + path.string());
+            encoded.clear();
+            encoded.shrink_to_fit();
+            return path.string();
+        }
+    } // namespace
+
+    ThumbnailSet SlideDetector::make_thumbnails(const VideoSource &video, const std::vector<int> &frame_indices,
+                                                const ThumbnailOptions &options) const
+    {
+        if (options.width < 1)
+            throw std::invalid_argument("Thumbnail width must be >= 1");
+        if (options.encoding.empty())
+            throw std::invalid_argument("Thumbnail encoding must not be empty");
+        if (options.quality < 1 || options.quality > 100)
+            throw std::invalid_argument("Thumbnail quality must be within 1 - 100");
+        if (options.sprite_sheet && options.sprite_columns < 1)
+            throw std::invalid_argument("Sprite sheet columns must be >= 1");
+
+        ThumbnailSet result;
+        result.thumbnails.resize(frame_indices.size());
+        for (size_t i = 0; i < frame_indices.size(); i++)
+            result.thumbnails[i].frame_index = frame_indices[i];
+        if (frame_indices.empty())
+            return result;
+
+        const std::filesystem::path directory(options.output_dir);
+        if (!options.output_dir.empty())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(directory, ec);
+            if (ec)
+                throw std::runtime_error("Could not create thumbnail directory " + options.output_dir);
+        }
+        const std::vector<int> params = encode_params(options);
+
+        // Each frame is encoded once (duplicates would also write the same slide_<idx> file twice)
+        std::vector<int> unique_indices(frame_indices);
+        std::sort(unique_indices.begin(), unique_indices.end());
+        unique_indices.erase(std::unique(unique_indices.begin(), unique_indices.end()), unique_indices.end());
+
+        // 1. Decode on this thread, downscale + encode on the pool
+        std::vector<Thumbnail> encoded(unique_indices.size());
+        std::vector<cv::Mat> unique_tiles(unique_indices.size()); // Kept only for the sprite sheet
+        std::vector<std::future<void>> pending;
+        pending.reserve(unique_indices.size());
+        size_t completed = 0;
+        {
+            ThreadPool pool(resolved_num_threads());
+            cv::VideoCapture cap;
+            open_capture(cap, video);
+            visit_frames(cap, unique_indices, [&](size_t slot, const cv::Mat &frame)
+                         {
+                // At most one full-resolution frame per worker in flight: the decoder waits for the oldest
+                if (pending.size() - completed >= static_cast<size_t>(pool.size()))
+                    pending[completed++].get();
+
+                pending.push_back(pool.submit([&, slot, frame]()
+                                              {
+                Thumbnail &thumbnail = encoded[slot];
+                thumbnail.frame_index = unique_indices[slot];
+                cv::Mat small;
+                if (frame.cols > options.width)
+                {
+                    const double scale = static_cast<double>(options.width) / frame.cols;
+                    cv::resize(frame, small, cv::Size(), scale, scale, cv::INTER_AREA);
+                }
+                else
+                {
+                    small = frame.clone(); // Own copy: the decoded frame is released with the task
+                }
+
+                thumbnail.encoded = encode(small, options, params);
+                if (!options.output_dir.empty())
+                    thumbnail.path = write_file(directory / ("slide_" + std::to_string(thumbnail.frame_index) + options.encoding),
+                                                thumbnail.encoded);
+                if (options.sprite_sheet)
+                    unique_tiles[slot] = std::move(small); })); });
+            cap.release();
+
+            // get() rethrows the first failure; the pool finishes the rest before it is destroyed
+            for (; completed < pending.size(); completed++)
+                pending[completed].get();
+        }
+
+        // Every requested slot gets the thumbnail of its frame (missing frames stay empty).
+        // The last slot of a frame takes the bytes, earlier duplicates copy them.
+        std::vector<size_t> unique_slot(frame_indices.size());
+        std::vector<size_t> last_slot(unique_indices.size());
+        for (size_t i = 0; i < frame_indices.size(); i++)
+        {
+            unique_slot[i] = static_cast<size_t>(
+                std::lower_bound(unique_indices.begin(), unique_indices.end(), frame_indices[i]) - unique_indices.begin());
+            last_slot[unique_slot[i]] = i;
+        }
+        std::vector<cv::Mat> tiles(frame_indices.size());
+        for (size_t i = 0; i < frame_indices.size(); i++)
+        {
+            const size_t u = unique_slot[i];
+            if (encoded[u].encoded.empty() && encoded[u].path.empty())
+                continue;
+            if (last_slot[u] == i)
+                result.thumbnails[i] = std::move(encoded[u]);
+            else
+                result.thumbnails[i] = encoded[u];
+            tiles[i] = unique_tiles[u]; // Shared, only read by the sprite sheet
+        }
+
+        if (!options.sprite_sheet)
+            return result;
+
+        // 2. Sprite sheet: tiles of the first thumbnail's size, missing frames stay black
+        auto first = std::find_if(tiles.begin(), tiles.end(), [](const cv::Mat &tile)
+                                  { return !tile.empty(); });
+        if (first == tiles.end())
+            return result;
+
+        const int count = static_cast<int>(tiles.size());
+        result.sprite_columns = std::min(options.sprite_columns, count);
+        result.tile_size = first->size();
+        const int rows = (count + result.sprite_columns - 1) / result.sprite_columns;
+        cv::Mat sheet(rows * result.tile_size.height, result.sprite_columns * result.tile_size.width, first->type(),
+                      cv::Scalar::all(0));
+        for (int i = 0; i < count; i++)
+        {
+            if (tiles[i].empty())
+                continue;
+            cv::Mat cell = sheet(cv::Rect((i % result.sprite_columns) * result.tile_size.width,
+                                          (i / result.sprite_columns) * result.tile_size.height,
+                                          result.tile_size.width, result.tile_size.height));
+            if (tiles[i].size() == result.tile_size)
+                tiles[i].copyTo(cell);
+            else
+                cv::resize(tiles[i], cell, result.tile_size, 0, 0, cv::INTER_AREA);
+        }
+
+        result.sprite = encode(sheet, options, params);
+        if (!options.output_dir.empty())
+            result.sprite_path = write_file(directory / ("sprite" + options.encoding), result.sprite);
+        return result;
+    }
+
+} // namespace ai_interview
@@ -0,0 +1,143 @@
+#include "ai_interview/thread_pool.hpp"
+#include <algorithm>
+
+namespace ai_interview
+{
+    namespace
+    {
+        // Pool and worker index of the current thread (nullptr outside a pool worker)
+        thread_local const ThreadPool *current_pool = nullptr;
+        thread_local int current_worker = -1;
+    }
+
+    ThreadPool::ThreadPool(int num_threads)
+    {
+        if (num_threads <= 0)
+            num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+        queues_.reserve(num_threads);
+        for (int i = 0; i < num_threads; i++)
+            queues_.push_back(std::make_unique<WorkerQueue>());
+
+        workers_.reserve(num_threads);
+        try
+        {
+            for (int i = 0; i < num_threads; i++)
+                workers_.emplace_back([this, i]()
+                                      { worker_loop(i); });
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            work_available_.notify_all();
+            for (auto &worker : workers_)
+                worker.join();
+            throw;
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    void ThreadPool::post(Task task)
+    {
+        size_t target;
+        if (current_pool == this)
+        {
+            target = static_cast<size_t>(current_worker);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            target = next_queue_++ % queues_.size();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_++;
+        }
+        work_available_.notify_one();
+    }
+
+    void ThreadPool::wait_idle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]()
+                   { return pending_ == 0 && running_ == 0; });
+    }
+
+    bool ThreadPool::take_task(int index, Task &task)
+    {
+        const int n = static_cast<int>(queues_.size());
+        for (int i = 0; i < n; i++)
+        {
+            WorkerQueue &queue = *queues_[(index + i) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::worker_loop(int index)
+    {
+        current_pool = this;
+        current_worker = index;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_available_.wait(lock, [this]()
+                                     { return pending_ > 0 || stopping_; });
+                if (pending_ == 0)
+                    return; // Stopping and nothing left
+                pending_--;
+                running_++;
+            }
+
+            // The claim guarantees a queued task for us. One scan can still miss it when other
+            // workers take tasks from deques we haven't reached yet, so scan again
+            Task task;
+            while (!take_task(index, task))
+                std::this_thread::yield();
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                // post() tasks have nobody to report to; submit() stores exceptions in the future
+            }
+            task = nullptr; // Release captures before reporting idle
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_--;
+                if (pending_ == 0 && running_ == 0)
+                    idle_.notify_all();
+            }
+        }
+    }
+
+} // namespace ai_interview
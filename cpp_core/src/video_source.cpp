@@ -0,0 +1,307 @@
+#include "ai_interview/video_source.hpp"
+#include <opencv2/core/version.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// cv::VideoCapture::open(Ptr<IStreamReader>, ...) appeared in OpenCV 4.11
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 11)
+#define AI_INTERVIEW_HAS_STREAM_READER 1
+#else
+#define AI_INTERVIEW_HAS_STREAM_READER 0
+#endif
+
+namespace ai_interview
+{
+
+    struct VideoSource::Data
+    {
+        Kind kind = Kind::File;
+        std::string path;
+
+        // Memory: a view of someone else's bytes, or of `buffer` (drained pipe)
+        const uint8_t *bytes = nullptr;
+        size_t size = 0;
+        std::shared_ptr<const void> owner;
+        std::vector<uint8_t> buffer;
+
+        // Reader
+        ReadFn read;
+        SeekFn seek;
+
+        // In-memory file fallback, created on first use
+        std::mutex mutex;
+        int memfd = -1;
+        std::string memfd_path;
+
+        ~Data()
+        {
+#ifdef __linux__
+            if (memfd >= 0)
+                ::close(memfd);
+#endif
+        }
+
+        const std::string &materialize();
+    };
+
+    namespace
+    {
+#ifdef __linux__
+        void write_all(int fd, const uint8_t *data, size_t size)
+        {
+            while (size > 0)
+            {
+                const ssize_t written = ::write(fd, data, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error("Could not write the in-memory video file");
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+#endif
+
+        long long seek_position(long long current, long long size, long long offset, int origin)
+        {
+            long long base = 0;
+            if (origin == SEEK_CUR)
+                base = current;
+            else if (origin == SEEK_END)
+                base = size;
+            else if (origin != SEEK_SET)
+                return -1;
+
+            const long long position = base + offset;
+            return position < 0 || position > size ? -1 : position;
+        }
+
+#if AI_INTERVIEW_HAS_STREAM_READER
+        // One per capture: every open reads the shared buffer from its own position
+        class MemoryReader : public cv::IStreamReader
+        {
+        public:
+            MemoryReader(const uint8_t *data, long long size) : data_(data), size_(size) {}
+
+            long long read(char *buffer, long long size) override
+            {
+                const long long count = std::max(0LL, std::min(size, size_ - position_));
+                std::copy(data_ + position_, data_ + position_ + count, buffer);
+                position_ += count;
+                return count;
+            }
+
+            long long seek(long long offset, int origin) override
+            {
+                const long long position = seek_position(position_, size_, offset, origin);
+                if (position >= 0)
+                    position_ = position;
+                return position;
+            }
+
+        private:
+            const uint8_t *data_;
+            long long size_;
+            long long position_ = 0;
+        };
+
+        // Forwards to the user callbacks, rewound first: the previous capture may have left it anywhere
+        class CallbackReader : public cv::IStreamReader
+        {
+        public:
+            CallbackReader(const VideoSource::ReadFn &read, const VideoSource::SeekFn &seek) : read_(read), seek_(seek)
+            {
+                if (seek_(0, SEEK_SET) != 0)
+                    throw std::runtime_error("Could not rewind the video stream");
+            }
+
+            long long read(char *buffer, long long size) override { return read_(buffer, size); }
+            long long seek(long long offset, int origin) override { return seek_(offset, origin); }
+
+        private:
+            VideoSource::ReadFn read_;
+            VideoSource::SeekFn seek_;
+        };
+#endif
+    } // namespace
+
+    const std::string &VideoSource::Data::materialize()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!memfd_path.empty())
+            return memfd_path;
+
+#ifdef __linux__
+        const int fd = ::memfd_create("ai_interview_video", MFD_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("Could not create an in-memory video file");
+
+        try
+        {
+            if (kind == Kind::Memory)
+            {
+                write_all(fd, bytes, size);
+            }
+            else
+            {
+                if (seek(0, SEEK_SET) != 0)
+                    throw std::runtime_error("Could not rewind the video stream");
+                std::vector<char> chunk(VIDEO_SOURCE_READ_CHUNK);
+                long long count = 0;
+                while ((count = read(chunk.data(), static_cast<long long>(chunk.size()))) > 0)
+                    write_all(fd, reinterpret_cast<const uint8_t *>(chunk.data()), static_cast<size_t>(count));
+            }
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        // Opening /proc/self/fd/N gives every capture its own file offset
+        memfd = fd;
+        memfd_path = "/proc/self/fd/" + std::to_string(fd);
+        return memfd_path;
+#else
+        throw std::runtime_error("In-memory video input needs OpenCV 4.11 or newer on this platform");
+#endif
+    }
+
+    VideoSource::VideoSource(std::shared_ptr<Data> data) : data_(std::move(data)) {}
+
+    VideoSource::VideoSource(const std::string &path) : data_(std::make_shared<Data>())
+    {
+        data_->path = path;
+    }
+
+    VideoSource::VideoSource(const char *path) : VideoSource(std::string(path)) {}
+
+    VideoSource VideoSource::from_memory(const void *data, size_t size, std::shared_ptr<const void> owner)
+    {
+        if (!data || size == 0)
+            throw std::invalid_argument("Video buffer is empty");
+
+        auto source = std::make_shared<Data>();
+        source->kind = Kind::Memory;
+        source->bytes = static_cast<const uint8_t *>(data);
+        source->size = size;
+        source->owner = std::move(owner);
+        return VideoSource(std::move(source));
+    }
+
+    VideoSource VideoSource::from_reader(ReadFn read, SeekFn seek)
+    {
+        if (!read)
+            throw std::invalid_argument("Video stream needs a read function");
+
+        auto source = std::make_shared<Data>();
+        if (seek)
+        {
+            source->kind = Kind::Reader;
+            source->read = std::move(read);
+            source->seek = std::move(seek);
+            return VideoSource(std::move(source));
+        }
+
+        // Not seekable: keep the whole stream in memory
+        std::vector<uint8_t> &buffer = source->buffer;
+        long long count = 0;
+        do
+        {
+            const size_t used = buffer.size();
+            buffer.resize(used + VIDEO_SOURCE_READ_CHUNK);
+            count = read(reinterpret_cast<char *>(buffer.data() + used), static_cast<long long>(VIDEO_SOURCE_READ_CHUNK));
+            buffer.resize(used + static_cast<size_t>(std::max(0LL, count)));
+        } while (count > 0);
+
+        if (buffer.empty())
+            throw std::invalid_argument("Video stream is empty");
+        source->kind = Kind::Memory;
+        source->bytes = buffer.data();
+        source->size = buffer.size();
+        return VideoSource(std::move(source));
+    }
+
+    VideoSource::Kind VideoSource::kind() const
+    {
+        return data_->kind;
+    }
+
+    const std::string &VideoSource::path() const
+    {
+        return data_->path;
+    }
+
+    const uint8_t *VideoSource::data() const
+    {
+        return data_->bytes;
+    }
+
+    size_t VideoSource::size() const
+    {
+        return data_->size;
+    }
+
+    std::string VideoSource::description() const
+    {
+        switch (data_->kind)
+        {
+        case Kind::Memory:
+            return "<memory buffer, " + std::to_string(data_->size) + " bytes>";
+        case Kind::Reader:
+            return "<video stream>";
+        default:
+            return data_->path;
+        }
+    }
+
+    bool VideoSource::open(cv::VideoCapture &cap, const std::vector<int> &params) const
+    {
+        if (data_->kind == Kind::File)
+            return params.empty() ? cap.open(data_->path) : cap.open(data_->path, cv::CAP_ANY, params);
+
+#if AI_INTERVIEW_HAS_STREAM_READER
+        cv::Ptr<cv::IStreamReader> reader;
+        if (data_->kind == Kind::Memory)
+            reader = cv::makePtr<MemoryReader>(data_->bytes, static_cast<long long>(data_->size));
+        else
+            reader = cv::makePtr<CallbackReader>(data_->read, data_->seek);
+        if (cap.open(reader, cv::CAP_ANY, params))
+            return true;
+        // Callers retry without params (hardware decode) before the bytes get copied below
+        if (!params.empty())
+            return false;
+#endif
+
+        const std::string &path = data_->materialize();
+        return params.empty() ? cap.open(path) : cap.open(path, cv::CAP_ANY, params);
+    }
+
+    std::string VideoSource::file_path() const
+    {
+        if (data_->kind == Kind::File)
+            return data_->path;
+#if AI_INTERVIEW_HAS_STREAM_READER
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        return data_->memfd_path;
+#else
+        return data_->materialize();
+#endif
+    }
+
+    bool VideoSource::supports_concurrent_open() const
+    {
+        return data_->kind != Kind::Reader || !file_path().empty();
+    }
+
+} // namespace ai_interview
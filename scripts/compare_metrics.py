@@ -0,0 +1,81 @@
+"""
+Change Metric Validation
+
+Runs the C++ slide detector with the reference change metric engine
+(ChangeMetric.CONTOURS) and the fast ones (TILES, PACKED_TILES, and TILES on
+ComputeBackend.OPENCL) on a set of videos and checks that they produce the
+same slide decisions.
+
+Usage:
+    python scripts/compare_metrics.py <video.mp4> [<video2.mp4> ...]
+
+Exit code is 1 if any video produces different slides.
+"""
+
+import sys
+import time
+from pathlib import Path
+from typing import List, Tuple
+
+PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
+sys.path.insert(0, str(PROJECT_ROOT / "libs"))
+
+import ai_interview_cpp  # noqa: E402
+
+MIN_SCENE_DURATION = 2.0
+MIN_AREA_RATIO = 0.15
+
+
+def run(video_path: str, metric, backend=None) -> Tuple[List[int], float]:
+    """
+    Detect slides with the given metric.
+
+    Returns:
+        Frame indices of detected slides and elapsed seconds
+    """
+    detector = ai_interview_cpp.SlideDetector(MIN_SCENE_DURATION, MIN_AREA_RATIO)
+    detector.change_metric = metric
+    if backend is not None:
+        detector.compute_backend = backend
+
+    start = time.time()
+    segments = detector.process_video(video_path)
+    return [seg.frame_index for seg in segments], time.time() - start
+
+
+def main() -> int:
+    if len(sys.argv) < 2:
+        print("Usage: python scripts/compare_metrics.py <video.mp4> [...]")
+        return 2
+
+    mismatches = 0
+    for video_path in sys.argv[1:]:
+        contours, t_contours = run(video_path, ai_interview_cpp.ChangeMetric.CONTOURS)
+        print(f"{video_path}: CONTOURS={len(contours)} slides ({t_contours:.2f}s)")
+
+        variants = [
+            ("TILES", ai_interview_cpp.ChangeMetric.TILES, None),
+            ("PACKED_TILES", ai_interview_cpp.ChangeMetric.PACKED_TILES, None),
+            ("OPENCL/TILES", ai_interview_cpp.ChangeMetric.TILES, ai_interview_cpp.ComputeBackend.OPENCL),
+        ]
+        for name, metric, backend in variants:
+            slides, elapsed = run(video_path, metric, backend)
+
+            only_contours = sorted(set(contours) - set(slides))
+            only_fast = sorted(set(slides) - set(contours))
+            status = "OK" if not only_contours and not only_fast else "DIFF"
+            if status == "DIFF":
+                mismatches += 1
+
+            print(f"    [{status}] {name}={len(slides)} slides ({elapsed:.2f}s)")
+            if only_contours:
+                print(f"        only CONTOURS: frames {only_contours}")
+            if only_fast:
+                print(f"        only {name}: frames {only_fast}")
+
+    return 1 if mismatches else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,150 @@
+#include "ai_interview/change_metrics.hpp"
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// The packed edge path of ChangeMetric::PackedTiles (pack -> dilate_packed_edges -> clear_packed_rect of
+// the exclude rectangles) must give the same maps as the 8-bit path (cv::dilate -> mask_excluded).
+
+namespace ai_interview
+{
+
+    namespace
+    {
+        // Odd widths, exact and off-by-one word boundaries, single rows / columns
+        const cv::Size SIZES[] = {{1, 1}, {1, 9}, {63, 1}, {64, 2}, {65, 3}, {127, 5}, {128, 8}, {129, 7}, {200, 31}, {333, 17}};
+
+        // 0/255 map with roughly `density` edge pixels, plus edges on every border row and column
+        cv::Mat random_edges(cv::Size size, double density, cv::RNG &rng)
+        {
+            cv::Mat noise(size, CV_32FC1);
+            rng.fill(noise, cv::RNG::UNIFORM, 0.0, 1.0);
+            cv::Mat edges = noise < density;
+
+            for (int x = 0; x < size.width; x += 3)
+            {
+                edges.at<uchar>(0, x) = 255;
+                edges.at<uchar>(size.height - 1, size.width - 1 - x) = 255;
+            }
+            for (int y = 0; y < size.height; y += 4)
+            {
+                edges.at<uchar>(y, 0) = 255;
+                edges.at<uchar>(size.height - 1 - y, size.width - 1) = 255;
+            }
+            return edges;
+        }
+
+        // Exclude rectangle inside the map; every other one touches a border
+        cv::Rect random_rect(cv::Size size, cv::RNG &rng, bool at_border)
+        {
+            int x0 = rng.uniform(0, size.width);
+            int y0 = rng.uniform(0, size.height);
+            int x1 = rng.uniform(x0 + 1, size.width + 1);
+            int y1 = rng.uniform(y0 + 1, size.height + 1);
+            if (at_border)
+            {
+                if (rng.uniform(0, 2) == 0)
+                    x0 = 0;
+                else
+                    x1 = size.width;
+                if (rng.uniform(0, 2) == 0)
+                    y0 = 0;
+                else
+                    y1 = size.height;
+            }
+            return cv::Rect(x0, y0, x1 - x0, y1 - y0);
+        }
+
+        void expect_same(const PackedEdges &packed, const cv::Mat &expected)
+        {
+            PackedEdges reference;
+            pack_edges(expected, reference);
+            ASSERT_EQ(packed.rows, reference.rows);
+            ASSERT_EQ(packed.cols, reference.cols);
+            ASSERT_EQ(packed.words_per_row, reference.words_per_row);
+            EXPECT_EQ(packed.bits, reference.bits); // Padding bits included
+
+            cv::Mat unpacked;
+            unpack_edges(packed, unpacked);
+            const cv::Mat mismatch = unpacked != expected;
+            EXPECT_EQ(cv::countNonZero(mismatch), 0);
+        }
+    } // namespace
+
+    TEST(PackedEdges, DilateMatchesCvDilate)
+    {
+        cv::RNG rng(12345);
+        const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
+        std::vector<uint64_t> rows;
+
+        for (const cv::Size size : SIZES)
+        {
+            for (double density : {0.0, 0.01, 0.1, 0.5})
+            {
+                SCOPED_TRACE(testing::Message() << size.width << "x" << size.height << " density " << density);
+                const cv::Mat edges = random_edges(size, density, rng);
+
+                cv::Mat expected;
+                cv::dilate(edges, expected, kernel);
+
+                PackedEdges packed;
+                pack_edges(edges, packed);
+                dilate_packed_edges(packed, rows);
+                expect_same(packed, expected);
+            }
+        }
+    }
+
+    TEST(PackedEdges, DilateAndMaskMatchesMaskedCvDilate)
+    {
+        cv::RNG rng(54321);
+        const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
+        std::vector<uint64_t> rows;
+
+        for (const cv::Size size : SIZES)
+        {
+            for (int trial = 0; trial < 8; trial++)
+            {
+                SCOPED_TRACE(testing::Message() << size.width << "x" << size.height << " trial " << trial);
+                const cv::Mat edges = random_edges(size, 0.05, rng);
+
+                std::vector<cv::Rect> rects;
+                for (int i = 0; i < 1 + trial % 3; i++)
+                    rects.push_back(random_rect(size, rng, i % 2 == 0));
+
+                // mask_excluded on the 8-bit map
+                cv::Mat expected;
+                cv::dilate(edges, expected, kernel);
+                for (const auto &rect : rects)
+                    expected(rect).setTo(cv::Scalar(0));
+
+                PackedEdges packed;
+                pack_edges(edges, packed);
+                dilate_packed_edges(packed, rows);
+                for (const auto &rect : rects)
+                    clear_packed_rect(packed, rect);
+                expect_same(packed, expected);
+            }
+        }
+    }
+
+    TEST(PackedEdges, ClearRectAtWordBoundaries)
+    {
+        const cv::Size size(200, 6);
+        const cv::Mat full(size, CV_8UC1, cv::Scalar(255));
+        const cv::Rect rects[] = {{0, 0, 64, 6}, {63, 1, 2, 1}, {64, 2, 64, 2}, {127, 0, 73, 6}, {199, 5, 1, 1}, {0, 0, 200, 6}};
+
+        for (const auto &rect : rects)
+        {
+            SCOPED_TRACE(testing::Message() << "rect " << rect.x << "," << rect.y << " " << rect.width << "x" << rect.height);
+            cv::Mat expected = full.clone();
+            expected(rect).setTo(cv::Scalar(0));
+
+            PackedEdges packed;
+            pack_edges(full, packed);
+            clear_packed_rect(packed, rect);
+            expect_same(packed, expected);
+        }
+    }
+
+} // namespace ai_interview